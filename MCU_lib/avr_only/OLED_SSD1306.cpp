@@ -6,7 +6,7 @@
  */ 
 #include "OLED_SSD1306.h"
 
-#if defined(__cplusplus) && defined(__AVR) && !defined(__NO_INCLUDE_OLED_CPP)
+#if defined(__cplusplus) && (defined(__AVR) || (defined(SSD1306_SIM) && SSD1306_SIM == 1)) && !defined(__NO_INCLUDE_OLED_CPP)
 
 
 
@@ -19,6 +19,8 @@
 
 //#pragma region CONSTRUCTOR_DESTRUCTOR_INIT
 
+#if OLED_SSD1306_OWN_BUFFER == 1
+
 /**
  * \brief Class constructor
  * \param newControlPinPort -The port for the control pins(ex. &PORTD)
@@ -51,6 +53,8 @@ OLED_SSD1306::OLED_SSD1306(volatile uint8_t* newControlPinPort, uint8_t csPinPos
 	#endif
 	screenWidth = 0;
 	screenHeight = 0;
+	displayBuffer = ownBuffer;
+	ClearDirty();
 }
 
 
@@ -90,6 +94,8 @@ bool newUseGraphicMode
 	#endif
 	screenWidth = 0;
 	screenHeight = 0;
+	displayBuffer = ownBuffer;
+	ClearDirty();
 }
 
 
@@ -129,6 +135,55 @@ uint8_t newCharMode
 	#endif
 	screenWidth = 0;
 	screenHeight = 0;
+	displayBuffer = ownBuffer;
+	ClearDirty();
+}
+
+
+
+#endif
+
+
+
+/**
+ * \brief Class constructor for a caller owned buffer, several objects may share one buffer
+ * \param newControlPinPort -The port for the control pins(ex. &PORTD)
+ * \param csPinPosition		-The position of the CS pin
+ * \param dcPinPosition		-The position of the DC pin
+ * \param resetPinPosition	-The position of the RESET pin
+ * \param useI2CTransmit 	-#ifdef TWCR, give option for selecting TWI for communication
+ * \param newUseGraphicMode -If using GRAPIC MODE on our OLED or if it is just text based
+ * \param newCharMode		-The char mode for our OLED to base character size on
+ * \param newDisplayBuffer	-Rows of 128 bytes, one for each page of the screen(ex. uint8_t buffer[4][128] for 128x32)
+ */
+OLED_SSD1306::OLED_SSD1306(volatile uint8_t* newControlPinPort, uint8_t csPinPosition, uint8_t dcPinPosition, uint8_t resetPinPosition,
+#ifdef TWCR
+bool useI2CTransmit,
+#endif
+bool newUseGraphicMode,
+uint8_t newCharMode,
+uint8_t (*newDisplayBuffer)[128]
+) 
+{
+	controlPinPort = newControlPinPort;
+	chipSelectPin = csPinPosition;
+	dcPin = dcPinPosition;
+	resetPin = resetPinPosition;
+	useGraphicMode = newUseGraphicMode;
+	
+	cursorPosX = 0;
+	cursorPosY = 0;
+	charMode = newCharMode;
+	
+	#ifdef TWCR
+	
+	useI2C = useI2CTransmit;
+	
+	#endif
+	screenWidth = 0;
+	screenHeight = 0;
+	displayBuffer = newDisplayBuffer;
+	ClearDirty();
 }
 
 
@@ -147,7 +202,9 @@ OLED_SSD1306::~OLED_SSD1306() {
 		useI2C = 0;
 	#endif
 	useGraphicMode = 0;
-	ClearBuffer();
+	
+	//The buffer may be shared with another object, so it is left as is
+	displayBuffer = 0;
 	
 	charMode = 0;
 	cursorPosX = 0;
@@ -455,11 +512,12 @@ void OLED_SSD1306::SendData(uint8_t data[], uint16_t size) {
  */
 void OLED_SSD1306::ClearScreen() {
 	for (uint8_t i = 0; i < screenHeight/8; i++){
-		memset(displayBuffer[i], 0x00, sizeof(displayBuffer[i]));
+		memset(displayBuffer[i], 0x00, screenWidth);
 		GoToPixelPosition(0,i);
-		SendData(displayBuffer[i], sizeof(displayBuffer[i]));
+		SendData(displayBuffer[i], screenWidth);
 	}
 	
+	ClearDirty();
 	GoToPixelPosition(0, 0);
 }
 
@@ -492,7 +550,8 @@ void OLED_SSD1306::GoToPixelPosition(uint8_t x, uint8_t y) {
 	}
 	cursorPosX=x;
 	cursorPosY=y;
-	uint8_t commandSequence[4] = {(uint8_t)(0xb0+y), (uint8_t)0x21, x, (uint8_t)0x7f};
+	//0xB0 only moves the page in page addressing mode, Initialize sets horizontal addressing so the page window is set as well
+	uint8_t commandSequence[7] = {(uint8_t)(0xb0+y), (uint8_t)0x21, x, (uint8_t)0x7f, (uint8_t)0x22, y, (uint8_t)(screenHeight/8-1)};
 	SendCommand(commandSequence, sizeof(commandSequence));
 }
 
@@ -622,7 +681,11 @@ void OLED_SSD1306::PrintText(char c, const char fontSheet[], uint8_t fontSheetCh
 		break;
 
 		default:
-			if(((cursorPosX-fontSheetCharacterLength)<=screenWidth))
+			if(charMode > 1)
+			{
+				PutScaled(c, fontSheet, fontSheetCharacterLength);
+			}
+			else if(((cursorPosX-fontSheetCharacterLength)<=screenWidth))
 			{
 				for (uint8_t j = 0; j < fontSheetCharacterLength; j++)
 				{
@@ -636,6 +699,7 @@ void OLED_SSD1306::PrintText(char c, const char fontSheet[], uint8_t fontSheetCh
 					}
 					
 				}
+				if(useGraphicMode) MarkDirty(cursorPosY, cursorPosX, cursorPosX+fontSheetCharacterLength-1);
 				cursorPosX+=fontSheetCharacterLength;
 			}
 			
@@ -660,6 +724,7 @@ void OLED_SSD1306::Put(char c) {
 	if(useGraphicMode) 
 	{
 		displayBuffer[cursorPosY][cursorPosX] = c;
+		MarkDirty(cursorPosY, cursorPosX, cursorPosX);
 	}
 	else 
 	{
@@ -751,7 +816,11 @@ void OLED_SSD1306::Put(PGM_P progmemS) {
 		break;
 
 		default:
-			if(((cursorPosX-fontSheetCharacterLength)<=screenWidth))
+			if(charMode > 1)
+			{
+				PutScaled(c, fontSheet, fontSheetCharacterLength);
+			}
+			else if(((cursorPosX-fontSheetCharacterLength)<=screenWidth))
 			{
 				for (uint8_t j = 0; j < fontSheetCharacterLength; j++)
 				{
@@ -765,6 +834,7 @@ void OLED_SSD1306::Put(PGM_P progmemS) {
 					}
 					
 				}
+				if(useGraphicMode) MarkDirty(cursorPosY, cursorPosX, cursorPosX+fontSheetCharacterLength-1);
 				cursorPosX+=fontSheetCharacterLength;
 			}
 			
@@ -774,6 +844,67 @@ void OLED_SSD1306::Put(PGM_P progmemS) {
 
 
 
+
+/**
+ * \brief Writes a char scaled up by the char mode, each glyph column is scaled with a table lookup per nibble
+ * 
+ * 
+ * \param c							-The char
+ * \param fontSheet					-The font sheet, starting at ' '
+ * \param fontSheetCharacterLength	-The width of each character before scaling
+ */
+void OLED_SSD1306::PutScaled(char c, const char fontSheet[], uint8_t fontSheetCharacterLength) {
+	uint8_t scale = min(charMode, FONT_SCALE_MAX);
+	uint8_t width = fontSheetCharacterLength * scale;
+	uint8_t startX = cursorPosX;
+	uint8_t startY = cursorPosY;
+	const char* glyph = &fontSheet[((uint8_t)c - ' ') * fontSheetCharacterLength];
+
+	if(startX + width > screenWidth || startY >= screenHeight/8) {
+		return;
+	}
+
+	uint8_t pages = min(scale, screenHeight/8 - startY);
+
+	for(uint8_t page = 0; page < pages; page++)
+	{
+		if(!useGraphicMode)
+		{
+			GoToPixelPosition(startX, startY + page);
+		}
+
+		for(uint8_t j = 0; j < fontSheetCharacterLength; j++)
+		{
+			uint8_t data = (uint8_t)(FontScaleColumn(glyph[j], scale) >> (page * 8));
+
+			for(uint8_t k = 0; k < scale; k++)
+			{
+				if(useGraphicMode)
+				{
+					displayBuffer[startY + page][startX + j*scale + k] = data;
+				}
+				else
+				{
+					SendData(data);
+				}
+			}
+		}
+
+		if(useGraphicMode) MarkDirty(startY + page, startX, startX + width - 1);
+	}
+
+	if(useGraphicMode)
+	{
+		cursorPosX = startX + width;
+	}
+	else
+	{
+		GoToPixelPosition(startX + width, startY);
+	}
+}
+
+
+
  /**
   * \brief Writes a string onto the screen
   * 
@@ -827,6 +958,10 @@ void OLED_SSD1306::Put(PGM_P progmemS) {
 		break;
 
 		default:
+			if(charMode > 1) {
+				PutScaled(c, fontSheet, fontSheetCharacterLength);
+				break;
+			}
 			if(cursorPosX+fontSheetCharacterLength > screenWidth) {
 				break;
 			}
@@ -842,6 +977,7 @@ void OLED_SSD1306::Put(PGM_P progmemS) {
 				}
 					
 			}
+			if(useGraphicMode) MarkDirty(cursorPosY, cursorPosX, cursorPosX+fontSheetCharacterLength-1);
 			cursorPosX+=fontSheetCharacterLength;
 			
 			
@@ -907,6 +1043,10 @@ void OLED_SSD1306::Put(PGM_P progmemS) {
 		break;
 
 		default:
+			if(charMode > 1) {
+				PutScaled(c, fontSheet, fontSheetCharacterLength);
+				break;
+			}
 			if(cursorPosX+fontSheetCharacterLength > screenWidth) {
 				break;
 			}
@@ -922,6 +1062,7 @@ void OLED_SSD1306::Put(PGM_P progmemS) {
 				}
 					
 			}
+			if(useGraphicMode) MarkDirty(cursorPosY, cursorPosX, cursorPosX+fontSheetCharacterLength-1);
 			cursorPosX+=fontSheetCharacterLength;
 			
 			
@@ -1002,6 +1143,9 @@ uint8_t OLED_SSD1306::DrawPixel(uint8_t x, uint8_t y, uint8_t color) {
 		displayBuffer[(y / 8)][x] &= ~(1 << (y % 8));
 	}
 	
+	//Marked even if unchanged, a shared buffer may already hold the pixel but this screen does not
+	MarkDirty(y / 8, x, x);
+	
 	return 0;
 	
 }
@@ -1200,13 +1344,21 @@ uint8_t OLED_SSD1306::DrawBitmap(uint8_t x, uint8_t y, const uint8_t *picture, u
 
 
 /**
- * \brief Updates the OLED screen display
+ * \brief Updates the OLED screen display, only the spans this object drew since its last Update are sent
  * 
  * 
  */
 void OLED_SSD1306::Update() {
-	GoToPixelPosition(0,0);
-	SendData(&displayBuffer[0][0], screenWidth*screenHeight/8);
+	for (uint8_t i = 0; i < screenHeight/8; i++){
+		if(dirtyStart[i] > dirtyEnd[i]) {
+			continue;
+		}
+		
+		GoToPixelPosition(dirtyStart[i], i);
+		SendData(&displayBuffer[i][dirtyStart[i]], dirtyEnd[i] - dirtyStart[i] + 1);
+	}
+	
+	ClearDirty();
 }
 
 
@@ -1218,8 +1370,36 @@ void OLED_SSD1306::Update() {
  */
 void OLED_SSD1306::ClearBuffer() {
 	for (uint8_t i = 0; i < screenHeight/8; i++){
-		memset(displayBuffer[i], 0x00, sizeof(displayBuffer[i]));
+		memset(displayBuffer[i], 0x00, screenWidth);
 	}
+	
+	Invalidate();
+}
+
+
+
+/**
+ * \brief Marks the whole screen dirty so the next Update sends all of it, ex. after another object redrew a shared buffer
+ * 
+ * 
+ */
+void OLED_SSD1306::Invalidate() {
+	for (uint8_t i = 0; i < screenHeight/8; i++){
+		dirtyStart[i] = 0;
+		dirtyEnd[i] = screenWidth-1;
+	}
+}
+
+
+
+/**
+ * \brief Marks every page clean
+ * 
+ * 
+ */
+void OLED_SSD1306::ClearDirty() {
+	memset(dirtyStart, 0xFF, sizeof(dirtyStart));
+	memset(dirtyEnd, 0x00, sizeof(dirtyEnd));
 }
 
 
@@ -1234,7 +1414,7 @@ void OLED_SSD1306::ClearBuffer() {
  */
 uint8_t OLED_SSD1306::CheckBuffer(uint8_t x, uint8_t y) {
 	if( x > screenWidth-1 || y > (screenHeight-1)) return 0; // out of Display
-	return displayBuffer[(y / (screenHeight/8))][x] & (1 << (y % (screenHeight/8)));
+	return displayBuffer[(y / 8)][x] & (1 << (y % 8));
 }
 
 
@@ -1,22 +1,42 @@
 /**
  * \file OLED_SSD1306.h
  * \author Tim Robbins
- * \brief Header file for SSD1306 OLED display
+ * \brief Header file for SSD1306 OLED display. \n
+ * OLED_SSD1306_T<width, height, Transport> is a compile time sized variant, its buffer is exactly width*height/8 bytes \n
+ * and the transport (OLED_SSD1306_SPI or OLED_SSD1306_I2C) is picked by type so no runtime branching is left in the byte and pixel paths.
+ * The buffer of OLED_SSD1306 can be caller owned and shared between objects, each object keeps its own dirty spans \n
+ * so Update() only sends what that object drew since its last Update(). \n
+ * Define OLED_SSD1306_OWN_BUFFER as 0 to drop the 1KB buffer inside each object, then only the buffer taking constructor is available. \n
+ * Defining SSD1306_SIM as 1 builds the classes for the host against the panel emulator in "ssd1306Sim.h", see OLED_SSD1306WidgetsTest.cpp.
  * \todo - Fix display buffer sizing
  */
 
+#if !defined(SSD1306_SIM) || SSD1306_SIM != 1
 #define __NO_INCLUDE_OLED_CPP	1
+#endif
 
 
-#if defined(__cplusplus) && defined(__AVR) && !defined(__NO_INCLUDE_OLED_CPP)
+#if defined(__cplusplus) && (defined(__AVR) || (defined(SSD1306_SIM) && SSD1306_SIM == 1)) && !defined(__NO_INCLUDE_OLED_CPP)
 #ifndef OLED_SSD1306_H_
 #define OLED_SSD1306_H_
 
 
 
+#if defined(SSD1306_SIM) && SSD1306_SIM == 1
+#include <stdint.h>
+#include "ssd1306Sim.h"
+
+//Program memory is ordinary memory on the host
+#define PROGMEM
+#define PGM_P								const char*
+#define pgm_read_byte(p)					(*(const uint8_t*)(p))
+#define memcpy_P							memcpy
+#else
 #include <avr/io.h>
-#include <string.h>
 #include <avr/pgmspace.h>
+#endif
+#include <string.h>
+#include <stdlib.h>
 #include "mcuUtils.h"
 #include "mcuDelays.h"
 #include "spi.h"
@@ -43,6 +63,11 @@
 #define SSD1306_NORMALSIZE 					1
 #define SSD1306_DOUBLESIZE 					2
 
+///1 if each OLED_SSD1306 object embeds its own 8x128 buffer for the constructors that do not take one
+#ifndef OLED_SSD1306_OWN_BUFFER
+#define OLED_SSD1306_OWN_BUFFER				1
+#endif
+
 
 
 
@@ -60,7 +85,16 @@ class OLED_SSD1306 {
 	
 	bool useGraphicMode;
 	uint8_t charMode;
-	uint8_t displayBuffer[8][128]; //Current max possible size, need to fix this
+	#if OLED_SSD1306_OWN_BUFFER == 1
+	uint8_t ownBuffer[8][128]; //Current max possible size, need to fix this
+	#endif
+	
+	///Rows of 128 bytes, one for each page, either ownBuffer or caller owned
+	uint8_t (*displayBuffer)[128];
+	
+	///First and last dirty column of each page since the last Update, start > end when clean
+	uint8_t dirtyStart[MAX_SSD1306_HEIGHT/8];
+	uint8_t dirtyEnd[MAX_SSD1306_HEIGHT/8];
 	uint16_t cursorPosX;
 	uint16_t cursorPosY;
 	
@@ -70,11 +104,13 @@ class OLED_SSD1306 {
 	
 	protected:
 	
-
+	void ClearDirty();
+	void PutScaled(char c, const char fontSheet[], uint8_t fontSheetCharacterLength);
 	
 	public:
 	
 
+	#if OLED_SSD1306_OWN_BUFFER == 1
 	OLED_SSD1306(volatile uint8_t* newControlPinPort, uint8_t csPinPosition, uint8_t dcPinPosition, uint8_t resetPinPosition
 	#ifdef TWCR
 	,bool useI2CTransmit
@@ -93,6 +129,15 @@ class OLED_SSD1306 {
 	bool newUseGraphicMode,
 	uint8_t newCharMode
 	);
+	#endif
+	OLED_SSD1306(volatile uint8_t* newControlPinPort, uint8_t csPinPosition, uint8_t dcPinPosition, uint8_t resetPinPosition,
+	#ifdef TWCR
+	bool useI2CTransmit,
+	#endif
+	bool newUseGraphicMode,
+	uint8_t newCharMode,
+	uint8_t (*newDisplayBuffer)[128]
+	);
 	
 
 	~OLED_SSD1306();
@@ -112,6 +157,15 @@ class OLED_SSD1306 {
 	inline void SetGraphicMode(bool graphicMode) {
 		useGraphicMode = graphicMode;
 	}
+	
+	/**
+	 * \brief Swaps the buffer drawn into, the whole screen is marked dirty
+	 * \param newDisplayBuffer -Caller owned rows of 128 bytes, at least screen height/8 of them
+	 */
+	inline void SetBuffer(uint8_t (*newDisplayBuffer)[128]) {
+		displayBuffer = newDisplayBuffer;
+		Invalidate();
+	}
 
 	inline void StopScroll() {
 		SendCommand(SSD1306_CMD_DEACTIVATE_SCROLL);
@@ -149,12 +203,748 @@ class OLED_SSD1306 {
 	uint8_t DrawBitmap(uint8_t x, uint8_t y, const uint8_t *picture, uint8_t width, uint8_t height, uint8_t color);
 	void Update();
 	void ClearBuffer();
+	void Invalidate();
 	uint8_t CheckBuffer(uint8_t x, uint8_t y);
 	void DisplayBlock(uint8_t x, uint8_t y, uint8_t width);
+	
+	/**
+	 * \brief Gets a page of the buffer for drawing into directly, ex. by the widgets in OLED_SSD1306Widgets.h
+	 * \param page -The page
+	 * \return uint8_t* The 128 byte row of the page
+	 */
+	inline uint8_t* GetBufferRow(uint8_t page) {
+		return displayBuffer[page];
+	}
+
+	/**
+	 * \brief Widens the dirty span of a page, for drawing done through GetBufferRow
+	 * \param page -The page
+	 * \param x1   -The first changed column
+	 * \param x2   -The last changed column
+	 */
+	inline void MarkDirty(uint8_t page, uint8_t x1, uint8_t x2) {
+		if(x1 < dirtyStart[page]) dirtyStart[page] = x1;
+		if(x2 > dirtyEnd[page]) dirtyEnd[page] = x2;
+	}
+
+	/**
+	 * \brief Gets the width given to Initialize
+	 * \return uint8_t The width in pixels, 0 before Initialize
+	 */
+	inline uint8_t GetScreenWidth() {
+		return screenWidth;
+	}
+
+	/**
+	 * \brief Gets the height given to Initialize, the buffer has screen height/8 pages
+	 * \return uint8_t The height in pixels, 0 before Initialize
+	 */
+	inline uint8_t GetScreenHeight() {
+		return screenHeight;
+	}
+
+};
+
+
+
+
+/**
+ * \brief SPI transport for OLED_SSD1306_T, chip select, data/command and reset share one port
+ */
+class OLED_SSD1306_SPI {
+	private:
+
+	volatile uint8_t* controlPinPort;
+	uint8_t chipSelectPin;
+	uint8_t dcPin;
+	uint8_t resetPin;
+
+	public:
+
+	/**
+	 * \brief Class constructor
+	 * \param newControlPinPort -The port for the control pins(ex. &PORTD)
+	 * \param csPinPosition		-The position of the CS pin
+	 * \param dcPinPosition		-The position of the DC pin
+	 * \param resetPinPosition	-The position of the RESET pin
+	 */
+	OLED_SSD1306_SPI(volatile uint8_t* newControlPinPort, uint8_t csPinPosition, uint8_t dcPinPosition, uint8_t resetPinPosition) :
+		controlPinPort(newControlPinPort), chipSelectPin(csPinPosition), dcPin(dcPinPosition), resetPin(resetPinPosition) {}
 
+	/**
+	 * \brief Raises the control pins and pulses the reset line
+	 */
+	inline void Reset() {
+		*controlPinPort |= (1<<chipSelectPin) | (1<<dcPin) | (1<<resetPin);
+		*controlPinPort &= ~(1<<resetPin);
+		delayForMilliseconds(10);
+		*controlPinPort |= (1<<resetPin);
+	}
+
+	/**
+	 * \brief Opens a transfer
+	 * \param isData -If the bytes that follow are data, else commands
+	 */
+	inline void Begin(bool isData) {
+		*controlPinPort &= ~(1 << chipSelectPin);
+
+		if(isData) {
+			*controlPinPort |= (1 << dcPin);
+		}
+		else {
+			*controlPinPort &= ~(1 << dcPin);
+		}
+	}
+
+	/**
+	 * \brief Sends a byte of the open transfer
+	 * \param byte -The byte
+	 */
+	inline void Write(uint8_t byte) {
+		SpiTransmit(byte);
+	}
+
+	/**
+	 * \brief Closes the transfer
+	 */
+	inline void End() {
+		*controlPinPort |= (1 << chipSelectPin);
+	}
 };
 
 
 
+#ifdef TWCR
+
+/**
+ * \brief I2C transport for OLED_SSD1306_T
+ */
+class OLED_SSD1306_I2C {
+	private:
+
+	uint8_t address;
+
+	public:
+
+	/**
+	 * \brief Class constructor
+	 * \param newAddress -The 7 bit address of the display, 0x3C or 0x3D
+	 */
+	OLED_SSD1306_I2C(uint8_t newAddress = 0x3C) : address(newAddress) {}
+
+	///I2C displays have no reset line to pulse
+	inline void Reset() {}
+
+	/**
+	 * \brief Opens a transfer
+	 * \param isData -If the bytes that follow are data, else commands
+	 */
+	inline void Begin(bool isData) {
+		I2CStart((address << 1) | 0);
+		I2CByte(isData ? SSD1306_CMD_SEND_DATA : SSD1306_CMD_SEND_CMD);
+	}
+
+	/**
+	 * \brief Sends a byte of the open transfer
+	 * \param byte -The byte
+	 */
+	inline void Write(uint8_t byte) {
+		I2CByte(byte);
+	}
+
+	/**
+	 * \brief Closes the transfer
+	 */
+	inline void End() {
+		i2c_stop();
+	}
+};
+
+#endif
+
+
+
+/**
+ * \brief SSD1306 OLED sized and wired at compile time
+ * \tparam width 		-The width of the screen, up to 128
+ * \tparam height 		-The height of the screen, 16, 32 or 64
+ * \tparam Transport 	-OLED_SSD1306_SPI or OLED_SSD1306_I2C
+ * \tparam graphicMode 	-If text goes into the buffer for Update(), else straight to the display
+ */
+template <uint8_t width, uint8_t height, class Transport, bool graphicMode = true>
+class OLED_SSD1306_T {
+	private:
+
+	///Fails to compile for a size the controller cannot drive
+	typedef char sizeCheck[(width > 0 && width <= 128 && height >= 16 && height <= MAX_SSD1306_HEIGHT && height % 8 == 0) ? 1 : -1];
+
+	Transport transport;
+	uint8_t displayBuffer[height/8][width];
+	uint8_t cursorPosX;
+	uint8_t cursorPosY;
+
+	public:
+
+	///Bytes used by the display buffer
+	static const uint16_t bufferSize = (uint16_t)width * height / 8;
+
+	/**
+	 * \brief Class constructor
+	 * \param newTransport -The transport, ex. OLED_SSD1306_SPI(&PORTB, 0, 1, 2)
+	 */
+	OLED_SSD1306_T(const Transport& newTransport) : transport(newTransport), cursorPosX(0), cursorPosY(0) {}
+
+	void Initialize(bool displayOn);
+
+	void SendCommand(uint8_t cmd);
+	void SendCommand(const uint8_t cmd[], uint16_t size);
+	void SendData(uint8_t data);
+	void SendData(const uint8_t data[], uint16_t size);
+
+	inline void StopScroll() {
+		SendCommand(SSD1306_CMD_DEACTIVATE_SCROLL);
+	}
+
+	void ClearScreen();
+	void GoToPixelPosition(uint8_t x, uint8_t y);
+
+	void SetInvert(bool invert);
+	void SetSleep(bool gotoSleep);
+	void SetContrast(uint8_t contrast);
+
+	void Put(char c, const char fontSheet[], uint8_t fontSheetCharacterLength);
+	void Put(const char* s, const char fontSheet[], uint8_t fontSheetCharacterLength);
+
+	void StartScrollRight(uint8_t start, uint8_t stop);
+	void StartScrollLeft(uint8_t start, uint8_t stop);
+
+	/**
+	 * \brief Draws a single pixel into the buffer, the bounds are constants so this folds down to a mask and a store
+	 * \param x 	-The x position
+	 * \param y 	-The y position
+	 * \param color -The color of pixel to draw
+	 * \return uint8_t 1 if out of display, 0 if worked
+	 */
+	inline uint8_t DrawPixel(uint8_t x, uint8_t y, uint8_t color) {
+		if(x >= width || y >= height) return 1; // out of Display
+
+		if(color == SSD1306_WHITE)
+		{
+			displayBuffer[(y / 8)][x] |= (1 << (y % 8));
+		}
+		else
+		{
+			displayBuffer[(y / 8)][x] &= ~(1 << (y % 8));
+		}
+
+		return 0;
+	}
+
+	uint8_t DrawLine(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t color);
+	uint8_t DrawRect(uint8_t px1, uint8_t py1, uint8_t px2, uint8_t py2, uint8_t color);
+	uint8_t FillRect(uint8_t px1, uint8_t py1, uint8_t px2, uint8_t py2, uint8_t color);
+	uint8_t DrawCircle(uint8_t centerX, uint8_t centerY, uint8_t radius, uint8_t color);
+	uint8_t FillCircle(uint8_t centerX, uint8_t centerY, uint8_t radius, uint8_t color);
+	uint8_t DrawBitmap(uint8_t x, uint8_t y, const uint8_t *picture, uint8_t bitmapWidth, uint8_t bitmapHeight, uint8_t color);
+
+	/**
+	 * \brief Sends the whole buffer to the display
+	 */
+	inline void Update() {
+		GoToPixelPosition(0, 0);
+		SendData(&displayBuffer[0][0], bufferSize);
+	}
+
+	/**
+	 * \brief Clears the display buffer
+	 */
+	inline void ClearBuffer() {
+		memset(displayBuffer, 0x00, bufferSize);
+	}
+
+	/**
+	 * \brief Checks the status of the display buffer
+	 * \param x -The x position to check
+	 * \param y -The y position to check
+	 * \return uint8_t Non zero if the pixel is set
+	 */
+	inline uint8_t CheckBuffer(uint8_t x, uint8_t y) {
+		if(x >= width || y >= height) return 0; // out of Display
+		return displayBuffer[(y / 8)][x] & (1 << (y % 8));
+	}
+
+	void DisplayBlock(uint8_t x, uint8_t y, uint8_t blockWidth);
+};
+
+
+
+/**
+ * \brief Resets and initializes the OLED
+ * \param displayOn -If our OLED starts off as ON
+ */
+template <uint8_t width, uint8_t height, class Transport, bool graphicMode>
+void OLED_SSD1306_T<width, height, Transport, graphicMode>::Initialize(bool displayOn) {
+	const uint8_t init_sequence[] = {
+		SSD1306_CMD_DISPLAY_OFF,
+		0x20, 0b00,      			// Horizontal addressing mode
+		0xB0,
+		0xC8,
+		0x00,
+		0x10,
+		0x40,
+		0x81, 0x3F,
+		0xA1,
+		0xA6,
+		0xA8, (uint8_t)(height-1),	// Multiplex ratio
+		0xA4,
+		0xD3, 0x00,
+		0xD5,
+		0xF0,
+		0xD9, 0x22,
+		0xDA, (uint8_t)(height == 64 ? 0x12 : 0x02),	// COM pins configuration
+		0xDB,
+		0x20,
+		0x8D, 0x14,
+		(displayOn ? (uint8_t)SSD1306_CMD_DISPLAY_ON : (uint8_t)SSD1306_CMD_DISPLAY_OFF)
+	};
+
+	transport.Reset();
+	SendCommand(init_sequence, sizeof(init_sequence));
+
+	ClearScreen();
+	SendCommand(SSD1306_CMD_DEACTIVATE_SCROLL);
+}
+
+
+
+/**
+ * \brief Sends a single command to the OLED
+ * \param cmd -The command to send
+ */
+template <uint8_t width, uint8_t height, class Transport, bool graphicMode>
+void OLED_SSD1306_T<width, height, Transport, graphicMode>::SendCommand(uint8_t cmd) {
+	transport.Begin(false);
+	transport.Write(cmd);
+	transport.End();
+}
+
+
+
+/**
+ * \brief Sends an array of commands to the OLED in one transfer
+ * \param cmd  -The commands to send
+ * \param size -The size of the array
+ */
+template <uint8_t width, uint8_t height, class Transport, bool graphicMode>
+void OLED_SSD1306_T<width, height, Transport, graphicMode>::SendCommand(const uint8_t cmd[], uint16_t size) {
+	transport.Begin(false);
+	for (uint16_t i = 0; i < size; i++) transport.Write(cmd[i]);
+	transport.End();
+}
+
+
+
+/**
+ * \brief Sends a single byte of data to the OLED
+ * \param data -The data to send
+ */
+template <uint8_t width, uint8_t height, class Transport, bool graphicMode>
+void OLED_SSD1306_T<width, height, Transport, graphicMode>::SendData(uint8_t data) {
+	transport.Begin(true);
+	transport.Write(data);
+	transport.End();
+}
+
+
+
+/**
+ * \brief Sends an array of bytes of data to the OLED in one transfer
+ * \param data -The datas to send
+ * \param size -The size of the array
+ */
+template <uint8_t width, uint8_t height, class Transport, bool graphicMode>
+void OLED_SSD1306_T<width, height, Transport, graphicMode>::SendData(const uint8_t data[], uint16_t size) {
+	transport.Begin(true);
+	for (uint16_t i = 0; i < size; i++) transport.Write(data[i]);
+	transport.End();
+}
+
+
+
+/**
+ * \brief Clears the buffer and the OLED screen
+ */
+template <uint8_t width, uint8_t height, class Transport, bool graphicMode>
+void OLED_SSD1306_T<width, height, Transport, graphicMode>::ClearScreen() {
+	ClearBuffer();
+	Update();
+}
+
+
+
+/**
+ * \brief Goes to the pixel column and page on the OLED screen
+ * \param x -The x position on the OLED screen
+ * \param y -The page on the OLED screen
+ */
+template <uint8_t width, uint8_t height, class Transport, bool graphicMode>
+void OLED_SSD1306_T<width, height, Transport, graphicMode>::GoToPixelPosition(uint8_t x, uint8_t y) {
+	if(x >= width || y >= height/8) {
+		return;// out of display
+	}
+	cursorPosX = x;
+	cursorPosY = y;
+	const uint8_t commandSequence[6] = {0x21, x, (uint8_t)(width-1), 0x22, y, (uint8_t)(height/8-1)};
+	SendCommand(commandSequence, sizeof(commandSequence));
+}
+
+
+
+/**
+ * \brief Sets the OLEDS screen inversion
+ * \param invert -Whether of not the OLED should be inverted colors
+ */
+template <uint8_t width, uint8_t height, class Transport, bool graphicMode>
+void OLED_SSD1306_T<width, height, Transport, graphicMode>::SetInvert(bool invert) {
+	SendCommand(invert ? 0xA7 : 0xA6);
+}
+
+
+
+/**
+ * \brief Puts the OLED to sleep or wakes up the OLED
+ * \param gotoSleep -Whether of not the OLED should sleep
+ */
+template <uint8_t width, uint8_t height, class Transport, bool graphicMode>
+void OLED_SSD1306_T<width, height, Transport, graphicMode>::SetSleep(bool gotoSleep) {
+	SendCommand(gotoSleep ? SSD1306_CMD_DISPLAY_OFF : SSD1306_CMD_DISPLAY_ON);
+}
+
+
+
+/**
+ * \brief Sets the contrast for the OLED
+ * \param contrast -The contrast value of the OLED
+ */
+template <uint8_t width, uint8_t height, class Transport, bool graphicMode>
+void OLED_SSD1306_T<width, height, Transport, graphicMode>::SetContrast(uint8_t contrast) {
+	const uint8_t commandSequence[2] = {SSD1306_CMD_SET_CONTRAST, contrast};
+	SendCommand(commandSequence, 2);
+}
+
+
+
+/**
+ * \brief Writes a char at the cursor, into the buffer in graphic mode else straight to the display
+ * \param c 						-The char
+ * \param fontSheet 				-The font sheet, starting at ' '
+ * \param fontSheetCharacterLength 	-The width of each character
+ */
+template <uint8_t width, uint8_t height, class Transport, bool graphicMode>
+void OLED_SSD1306_T<width, height, Transport, graphicMode>::Put(char c, const char fontSheet[], uint8_t fontSheetCharacterLength) {
+	switch (c)
+	{
+		//Backspace
+		case '\b':
+			if(cursorPosX >= fontSheetCharacterLength) {
+				GoToPixelPosition(cursorPosX-fontSheetCharacterLength, cursorPosY);
+				Put(' ', fontSheet, fontSheetCharacterLength);
+				GoToPixelPosition(cursorPosX-fontSheetCharacterLength, cursorPosY);
+			}
+		break;
+
+		//Next line
+		case '\n':
+			GoToPixelPosition(cursorPosX, cursorPosY+1);
+		break;
+
+		//Carriage return
+		case '\r':
+			GoToPixelPosition(0, cursorPosY);
+		break;
+
+		//Clear screen
+		case '\f':
+			ClearScreen();
+		break;
+
+		default:
+			if(cursorPosX + fontSheetCharacterLength > width) {
+				break;
+			}
+
+			const uint8_t* glyph = (const uint8_t*)&fontSheet[((uint8_t)c - ' ') * fontSheetCharacterLength];
+
+			if(graphicMode)
+			{
+				memcpy(&displayBuffer[cursorPosY][cursorPosX], glyph, fontSheetCharacterLength);
+			}
+			else
+			{
+				SendData(glyph, fontSheetCharacterLength);
+			}
+
+			cursorPosX += fontSheetCharacterLength;
+		break;
+	}
+}
+
+
+
+/**
+ * \brief Writes a string at the cursor
+ * \param s 						-The string
+ * \param fontSheet 				-The font sheet, starting at ' '
+ * \param fontSheetCharacterLength 	-The width of each character
+ */
+template <uint8_t width, uint8_t height, class Transport, bool graphicMode>
+void OLED_SSD1306_T<width, height, Transport, graphicMode>::Put(const char* s, const char fontSheet[], uint8_t fontSheetCharacterLength) {
+	while(*s) {
+		Put(*s++, fontSheet, fontSheetCharacterLength);
+	}
+}
+
+
+
+/**
+ * \brief Has the display start scrolling towards the right
+ * \param start -The scroll start page
+ * \param stop  -The scroll stop page
+ */
+template <uint8_t width, uint8_t height, class Transport, bool graphicMode>
+void OLED_SSD1306_T<width, height, Transport, graphicMode>::StartScrollRight(uint8_t start, uint8_t stop) {
+	const uint8_t cmds[] = {
+		SSD1306_CMD_HORIZONTAL_SCROLL_RIGHT, 0x00, start, 0x00, stop, 0x00, 0xff, SSD1306_CMD_ACTIVATE_SCROLL
+	};
+	SendCommand(cmds, sizeof(cmds));
+}
+
+
+
+/**
+ * \brief Has the display start scrolling towards the left
+ * \param start -The scroll start page
+ * \param stop  -The scroll stop page
+ */
+template <uint8_t width, uint8_t height, class Transport, bool graphicMode>
+void OLED_SSD1306_T<width, height, Transport, graphicMode>::StartScrollLeft(uint8_t start, uint8_t stop) {
+	const uint8_t cmds[] = {
+		SSD1306_CMD_HORIZONTAL_SCROLL_LEFT, 0x00, start, 0x00, stop, 0x00, 0xff, SSD1306_CMD_ACTIVATE_SCROLL
+	};
+	SendCommand(cmds, sizeof(cmds));
+}
+
+
+
+/**
+ * \brief Draws a line into the buffer
+ * \param x1 	-The starting x position
+ * \param y1 	-The starting y position
+ * \param x2 	-The ending x position
+ * \param y2 	-The ending y position
+ * \param color -The color of line to draw
+ * \return uint8_t The result of the last pixel drawn
+ */
+template <uint8_t width, uint8_t height, class Transport, bool graphicMode>
+uint8_t OLED_SSD1306_T<width, height, Transport, graphicMode>::DrawLine(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t color) {
+	uint8_t result;
+
+	int dx =  abs(x2-x1), sx = x1<x2 ? 1 : -1;
+	int dy = -abs(y2-y1), sy = y1<y2 ? 1 : -1;
+	int err = dx+dy, e2; /* error value e_xy */
+
+	while(1) {
+		result = DrawPixel(x1, y1, color);
+		if (x1==x2 && y1==y2) break;
+		e2 = 2*err;
+		if (e2 > dy) {
+			err += dy; x1 += sx;
+		}
+
+		if (e2 < dx) {
+			err += dx; y1 += sy;
+		}
+	}
+
+	return result;
+}
+
+
+
+/**
+ * \brief Draws a rectangle outline into the buffer
+ * \param px1 	-The starting x pixel position
+ * \param py1 	-The starting y pixel position
+ * \param px2 	-The ending x pixel position
+ * \param py2 	-The ending y pixel position
+ * \param color -The color of rectangle outline to draw
+ * \return uint8_t The result of the last line drawn
+ */
+template <uint8_t width, uint8_t height, class Transport, bool graphicMode>
+uint8_t OLED_SSD1306_T<width, height, Transport, graphicMode>::DrawRect(uint8_t px1, uint8_t py1, uint8_t px2, uint8_t py2, uint8_t color) {
+	DrawLine(px1, py1, px2, py1, color);
+	DrawLine(px2, py1, px2, py2, color);
+	DrawLine(px2, py2, px1, py2, color);
+	return DrawLine(px1, py2, px1, py1, color);
+}
+
+
+
+/**
+ * \brief Draws a filled rectangle into the buffer
+ * \param px1 	-The starting x pixel position
+ * \param py1 	-The starting y pixel position
+ * \param px2 	-The ending x pixel position
+ * \param py2 	-The ending y pixel position
+ * \param color -The fill color of rectangle to draw
+ * \return uint8_t 1 if any of it was out of display, 0 if worked
+ */
+template <uint8_t width, uint8_t height, class Transport, bool graphicMode>
+uint8_t OLED_SSD1306_T<width, height, Transport, graphicMode>::FillRect(uint8_t px1, uint8_t py1, uint8_t px2, uint8_t py2, uint8_t color) {
+	uint8_t result = 0;
+
+	if(px1 > px2) {
+		uint8_t temp = px1;
+		px1 = px2;
+		px2 = temp;
+	}
+	if(py1 > py2) {
+		uint8_t temp = py1;
+		py1 = py2;
+		py2 = temp;
+	}
+
+	for (uint8_t y = py1; ; y++) {
+		for (uint8_t x = px1; ; x++) {
+			result |= DrawPixel(x, y, color);
+			if(x == px2) break;
+		}
+		if(y == py2) break;
+	}
+
+	return result;
+}
+
+
+
+/**
+ * \brief Draws a circle outline into the buffer
+ * \param centerX -The center x position of the circle
+ * \param centerY -The center y position of the circle
+ * \param radius  -The radius of the circle
+ * \param color   -The color of the circles outline
+ * \return uint8_t The result of the last pixel drawn
+ */
+template <uint8_t width, uint8_t height, class Transport, bool graphicMode>
+uint8_t OLED_SSD1306_T<width, height, Transport, graphicMode>::DrawCircle(uint8_t centerX, uint8_t centerY, uint8_t radius, uint8_t color) {
+	uint8_t result;
+
+	int16_t f = 1 - radius;
+	int16_t ddF_x = 1;
+	int16_t ddF_y = -2 * radius;
+	int16_t x = 0;
+	int16_t y = radius;
+
+	result = DrawPixel(centerX  , centerY+radius, color);
+	result = DrawPixel(centerX  , centerY-radius, color);
+	result = DrawPixel(centerX+radius, centerY  , color);
+	result = DrawPixel(centerX-radius, centerY  , color);
+
+	while (x<y) {
+		if (f >= 0) {
+			y--;
+			ddF_y += 2;
+			f += ddF_y;
+		}
+		x++;
+		ddF_x += 2;
+		f += ddF_x;
+
+		result = DrawPixel(centerX + x, centerY + y, color);
+		result = DrawPixel(centerX - x, centerY + y, color);
+		result = DrawPixel(centerX + x, centerY - y, color);
+		result = DrawPixel(centerX - x, centerY - y, color);
+		result = DrawPixel(centerX + y, centerY + x, color);
+		result = DrawPixel(centerX - y, centerY + x, color);
+		result = DrawPixel(centerX + y, centerY - x, color);
+		result = DrawPixel(centerX - y, centerY - x, color);
+	}
+	return result;
+}
+
+
+
+/**
+ * \brief Draws a filled circle into the buffer
+ * \param centerX -The center x position of the circle
+ * \param centerY -The center y position of the circle
+ * \param radius  -The radius of the circle
+ * \param color   -The fill color of the circle
+ * \return uint8_t The result of the last circle drawn
+ */
+template <uint8_t width, uint8_t height, class Transport, bool graphicMode>
+uint8_t OLED_SSD1306_T<width, height, Transport, graphicMode>::FillCircle(uint8_t centerX, uint8_t centerY, uint8_t radius, uint8_t color) {
+	uint8_t result = 0;
+	for(uint8_t i = 0; i <= radius; i++){
+		result = DrawCircle(centerX, centerY, i, color);
+	}
+	return result;
+}
+
+
+
+/**
+ * \brief Draws a row-major progmem bitmap into the buffer
+ * \param x 			-The x position to draw at
+ * \param y 			-The y position to draw at
+ * \param picture 		-Progmem pointer for the picture to draw
+ * \param bitmapWidth 	-The width of the bitmap
+ * \param bitmapHeight 	-The height of the bitmap
+ * \param color 		-The color of the bitmap
+ * \return uint8_t The result of the last pixel drawn
+ */
+template <uint8_t width, uint8_t height, class Transport, bool graphicMode>
+uint8_t OLED_SSD1306_T<width, height, Transport, graphicMode>::DrawBitmap(uint8_t x, uint8_t y, const uint8_t *picture, uint8_t bitmapWidth, uint8_t bitmapHeight, uint8_t color) {
+	uint8_t result = 0, byteWidth = (bitmapWidth+7)/8;
+	for (uint8_t j = 0; j < bitmapHeight; j++) {
+		for(uint8_t i = 0; i < bitmapWidth; i++){
+			if(pgm_read_byte(picture + j * byteWidth + i / 8) & (128 >> (i & 7)))
+			{
+				result = DrawPixel(x+i, y+j, color);
+			}
+			else
+			{
+				result = DrawPixel(x+i, y+j, !color);
+			}
+		}
+	}
+	return result;
+}
+
+
+
+/**
+ * \brief Sends part of a page of the buffer to the display
+ * \param x 			-The x position to start at
+ * \param y 			-The page
+ * \param blockWidth 	-The width of the block
+ */
+template <uint8_t width, uint8_t height, class Transport, bool graphicMode>
+void OLED_SSD1306_T<width, height, Transport, graphicMode>::DisplayBlock(uint8_t x, uint8_t y, uint8_t blockWidth) {
+	if (y >= height/8 || x >= width)
+	{
+		return;
+	}
+
+	if (blockWidth > width - x) {
+		blockWidth = width - x;
+	}
+	GoToPixelPosition(x, y);
+	SendData(&displayBuffer[y][x], blockWidth);
+}
+
+
+
+
 #endif 
 #endif 
\ No newline at end of file
@@ -0,0 +1,352 @@
+/**
+ * \file OLED_SSD1306Widgets.cpp
+ * \author Tim Robbins
+ * \brief Source file for retained widgets drawn on an OLED_SSD1306
+ */
+#include "OLED_SSD1306Widgets.h"
+
+#if defined(__cplusplus) && (defined(__AVR) || (defined(SSD1306_SIM) && SSD1306_SIM == 1)) && !defined(__NO_INCLUDE_OLED_CPP)
+
+
+
+#ifndef OLED_SSD1306_WIDGETS_CPP_
+#define OLED_SSD1306_WIDGETS_CPP_
+
+
+
+//#pragma region WIDGET
+
+/**
+ * \brief Class constructor, the box is clipped to the screen of the display
+ * \param newOled	-The display drawn on
+ * \param x			-The first column of the box
+ * \param newPage	-The first page of the box
+ * \param newWidth	-The width of the box in columns
+ * \param newPages	-The height of the box in pages
+ */
+OLED_SSD1306_Widget::OLED_SSD1306_Widget(OLED_SSD1306& newOled, uint8_t x, uint8_t newPage, uint8_t newWidth, uint8_t newPages) : oled(newOled)
+{
+	uint8_t screenPages = oled.GetScreenHeight() / 8;
+
+	posX = x;
+	page = newPage;
+	width = (x < oled.GetScreenWidth()) ? min(newWidth, oled.GetScreenWidth() - x) : 0;
+	pages = (newPage < screenPages) ? min(newPages, screenPages - newPage) : 0;
+
+	//Off the screen, nothing is drawn
+	if(width == 0 || pages == 0) {
+		width = 0;
+		pages = 0;
+	}
+
+	damageX1 = 0xFF;
+	damageX2 = 0;
+}
+
+
+
+/**
+ * \brief Gets what changed since the last Render
+ * \return OLED_SSD1306_Damage The damage rectangle, x1 > x2 when nothing changed
+ */
+OLED_SSD1306_Damage OLED_SSD1306_Widget::GetDamage() {
+	OLED_SSD1306_Damage damage = {damageX1, damageX2, page, (uint8_t)(page + pages - 1)};
+	return damage;
+}
+
+
+
+/**
+ * \brief Sends the damaged columns of each page of the box through DisplayBlock
+ * \return true if anything was sent
+ */
+bool OLED_SSD1306_Widget::Render() {
+	if(damageX1 > damageX2 || pages == 0) {
+		return false;
+	}
+
+	for(uint8_t i = 0; i < pages; i++) {
+		oled.DisplayBlock(damageX1, page + i, damageX2 - damageX1 + 1);
+	}
+
+	damageX1 = 0xFF;
+	damageX2 = 0;
+
+	return true;
+}
+
+//#pragma endregion
+
+
+
+//#pragma region LABEL
+
+/**
+ * \brief Class constructor
+ * \param newOled						-The display drawn on
+ * \param x								-The first column of the label
+ * \param newPage						-The page of the label
+ * \param newLength						-The number of characters, up to OLED_WIDGET_LABEL_MAX
+ * \param newFontSheet					-The font sheet, starting at ' '
+ * \param newFontSheetCharacterLength	-The width of each character
+ */
+OLED_SSD1306_Label::OLED_SSD1306_Label(OLED_SSD1306& newOled, uint8_t x, uint8_t newPage, uint8_t newLength, const char newFontSheet[], uint8_t newFontSheetCharacterLength) :
+	OLED_SSD1306_Widget(newOled, x, newPage, (uint8_t)min((uint16_t)min(newLength, OLED_WIDGET_LABEL_MAX) * newFontSheetCharacterLength, 128), 1)
+{
+	fontSheet = newFontSheet;
+	fontSheetCharacterLength = newFontSheetCharacterLength;
+	length = width / newFontSheetCharacterLength;
+
+	//Nothing drawn yet, so the first SetText draws every character
+	memset(text, 0x00, sizeof(text));
+}
+
+
+
+/**
+ * \brief Sets the text, padded with spaces to the length of the label
+ * \param s -The text
+ */
+void OLED_SSD1306_Label::SetText(const char* s) {
+	if(length == 0 || pages == 0) {
+		return;
+	}
+
+	uint8_t* row = oled.GetBufferRow(page);
+
+	for(uint8_t i = 0; i < length; i++) {
+		char c = ' ';
+
+		if(*s) {
+			c = *s++;
+		}
+
+		if((uint8_t)c < ' ') {
+			c = ' ';
+		}
+
+		if(c == text[i]) {
+			continue;
+		}
+
+		text[i] = c;
+
+		uint8_t x = posX + i * fontSheetCharacterLength;
+		memcpy(&row[x], &fontSheet[((uint8_t)c - ' ') * fontSheetCharacterLength], fontSheetCharacterLength);
+		Damage(x, x + fontSheetCharacterLength - 1);
+	}
+}
+
+//#pragma endregion
+
+
+
+//#pragma region NUMBER
+
+/**
+ * \brief Class constructor
+ * \param newOled						-The display drawn on
+ * \param x								-The first column of the field
+ * \param newPage						-The page of the field
+ * \param newDigits						-The number of characters, including a minus sign
+ * \param newFontSheet					-The font sheet, starting at ' '
+ * \param newFontSheetCharacterLength	-The width of each character
+ */
+OLED_SSD1306_Number::OLED_SSD1306_Number(OLED_SSD1306& newOled, uint8_t x, uint8_t newPage, uint8_t newDigits, const char newFontSheet[], uint8_t newFontSheetCharacterLength) :
+	OLED_SSD1306_Label(newOled, x, newPage, newDigits, newFontSheet, newFontSheetCharacterLength)
+{
+	value = 0;
+	valid = false;
+	digits = length;
+}
+
+
+
+/**
+ * \brief Sets the value, shown right aligned or as stars if it does not fit
+ * \param newValue -The value
+ */
+void OLED_SSD1306_Number::SetValue(int32_t newValue) {
+	//Clipped to nothing, there is no room for even a digit
+	if(digits == 0) {
+		return;
+	}
+
+	if(valid && newValue == value) {
+		return;
+	}
+
+	value = newValue;
+	valid = true;
+
+	char s[OLED_WIDGET_LABEL_MAX + 1];
+	uint32_t magnitude = (newValue < 0) ? -(uint32_t)newValue : (uint32_t)newValue;
+	uint8_t i = digits;
+
+	s[i] = 0;
+
+	do {
+		s[--i] = '0' + magnitude % 10;
+		magnitude /= 10;
+	} while(magnitude && i);
+
+	bool overflow = magnitude != 0;
+
+	if(newValue < 0) {
+		if(i == 0) {
+			overflow = true;
+		}
+		else {
+			s[--i] = '-';
+		}
+	}
+
+	while(i) {
+		s[--i] = ' ';
+	}
+
+	if(overflow) {
+		memset(s, '*', digits);
+	}
+
+	SetText(s);
+}
+
+//#pragma endregion
+
+
+
+//#pragma region BAR
+
+/**
+ * \brief Class constructor
+ * \param newOled	-The display drawn on
+ * \param x			-The first column of the bar, its left cap
+ * \param newPage	-The first page of the bar
+ * \param newWidth	-The width of the bar including both caps
+ * \param newPages	-The height of the bar in pages
+ */
+OLED_SSD1306_Bar::OLED_SSD1306_Bar(OLED_SSD1306& newOled, uint8_t x, uint8_t newPage, uint8_t newWidth, uint8_t newPages) :
+	OLED_SSD1306_Widget(newOled, x, newPage, newWidth, newPages)
+{
+	filled = 0xFF;
+}
+
+
+
+/**
+ * \brief Draws inner columns of the bar as filled or as the empty outline
+ * \param first -The first inner column
+ * \param last  -The last inner column
+ * \param fill  -If the columns are filled
+ */
+void OLED_SSD1306_Bar::DrawColumns(uint8_t first, uint8_t last, bool fill) {
+	for(uint8_t i = 0; i < pages; i++) {
+		uint8_t byte = 0xFF;
+
+		if(!fill) {
+			byte = ((i == 0) ? 0x01 : 0x00) | ((i == pages - 1) ? 0x80 : 0x00);
+		}
+
+		memset(&oled.GetBufferRow(page + i)[posX + 1 + first], byte, last - first + 1);
+	}
+
+	Damage(posX + 1 + first, posX + 1 + last);
+}
+
+
+
+/**
+ * \brief Sets the value of the bar
+ * \param newValue -The value, clipped to maximum
+ * \param maximum  -The value of a full bar
+ */
+void OLED_SSD1306_Bar::SetValue(uint16_t newValue, uint16_t maximum) {
+	if(width < 3 || pages == 0) {
+		return;
+	}
+
+	uint8_t inner = width - 2;
+	uint8_t newFilled = maximum ? (uint32_t)min(newValue, maximum) * inner / maximum : 0;
+
+	//First draw, caps and an empty bar
+	if(filled == 0xFF) {
+		for(uint8_t i = 0; i < pages; i++) {
+			uint8_t* row = oled.GetBufferRow(page + i);
+			row[posX] = 0xFF;
+			row[posX + width - 1] = 0xFF;
+		}
+
+		Damage(posX, posX + width - 1);
+		DrawColumns(0, inner - 1, false);
+		filled = 0;
+	}
+
+	if(newFilled > filled) {
+		DrawColumns(filled, newFilled - 1, true);
+	}
+	else if(newFilled < filled) {
+		DrawColumns(newFilled, filled - 1, false);
+	}
+
+	filled = newFilled;
+}
+
+//#pragma endregion
+
+
+
+//#pragma region ICON
+
+/**
+ * \brief Class constructor
+ * \param newOled	-The display drawn on
+ * \param x			-The first column of the icon
+ * \param newPage	-The first page of the icon
+ * \param newWidth	-The width of the icon
+ * \param newPages	-The height of the icon in pages
+ */
+OLED_SSD1306_Icon::OLED_SSD1306_Icon(OLED_SSD1306& newOled, uint8_t x, uint8_t newPage, uint8_t newWidth, uint8_t newPages) :
+	OLED_SSD1306_Widget(newOled, x, newPage, newWidth, newPages)
+{
+	bitmap = 0;
+	drawn = false;
+	stride = newWidth;
+}
+
+
+
+/**
+ * \brief Sets the bitmap shown
+ * \param newBitmap -Progmem pointer to width bytes for each page, 0 to blank the icon
+ */
+void OLED_SSD1306_Icon::SetBitmap(const uint8_t* newBitmap) {
+	if(width == 0 || (drawn && newBitmap == bitmap)) {
+		return;
+	}
+
+	bitmap = newBitmap;
+	drawn = true;
+
+	for(uint8_t i = 0; i < pages; i++) {
+		uint8_t* row = oled.GetBufferRow(page + i);
+
+		if(bitmap) {
+			memcpy_P(&row[posX], bitmap + i * stride, width);
+		}
+		else {
+			memset(&row[posX], 0x00, width);
+		}
+	}
+
+	Damage(posX, posX + width - 1);
+}
+
+//#pragma endregion
+
+
+
+#endif
+
+
+#endif
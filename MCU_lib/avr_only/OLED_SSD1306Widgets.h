@@ -0,0 +1,164 @@
+/**
+ * \file OLED_SSD1306Widgets.h
+ * \author Tim Robbins
+ * \brief Header file for retained widgets drawn on an OLED_SSD1306. \n
+ * Each widget owns a page aligned box of the display buffer and keeps what it last drew there, \n
+ * setting the same value again costs nothing and a new value only redraws the columns that changed. \n
+ * The changed columns are kept as a damage rectangle until Render() sends them through DisplayBlock, \n
+ * so a tick that changes one digit sends one character instead of the whole screen. \n
+ * The changed columns are marked dirty on the display as well, so OLED_SSD1306::Update() sends them when it is used instead of Render(). \n
+ * Fonts are the same RAM font sheets OLED_SSD1306::Put takes, icons are page major bitmaps in progmem. \n
+ * Boxes are clipped to the screen given to OLED_SSD1306::Initialize when the widget is constructed, so construct widgets after it. \n
+ * A widget clipped to no columns or no pages draws nothing.
+ */
+#include "OLED_SSD1306.h"
+
+#if defined(__cplusplus) && (defined(__AVR) || (defined(SSD1306_SIM) && SSD1306_SIM == 1)) && !defined(__NO_INCLUDE_OLED_CPP)
+#ifndef OLED_SSD1306_WIDGETS_H_
+#define OLED_SSD1306_WIDGETS_H_
+
+
+
+///Most characters a label or numeric field can hold
+#ifndef OLED_WIDGET_LABEL_MAX
+#define OLED_WIDGET_LABEL_MAX				16
+#endif
+
+
+
+/**
+ * \brief Columns and pages a widget changed since its last Render, x1 > x2 when nothing changed
+ */
+struct OLED_SSD1306_Damage {
+	uint8_t x1;
+	uint8_t x2;
+	uint8_t page1;
+	uint8_t page2;
+};
+
+
+
+/**
+ * \brief Box and damage shared by every widget
+ */
+class OLED_SSD1306_Widget {
+	protected:
+
+	OLED_SSD1306& oled;
+	uint8_t posX;
+	uint8_t page;
+	uint8_t width;
+	uint8_t pages;
+	uint8_t damageX1;
+	uint8_t damageX2;
+
+	OLED_SSD1306_Widget(OLED_SSD1306& newOled, uint8_t x, uint8_t newPage, uint8_t newWidth, uint8_t newPages);
+
+	/**
+	 * \brief Widens the damage to cover columns of the box, and marks them dirty on each page of the box for Update()
+	 * \param x1 -The first changed column
+	 * \param x2 -The last changed column
+	 */
+	inline void Damage(uint8_t x1, uint8_t x2) {
+		if(x1 < damageX1) damageX1 = x1;
+		if(x2 > damageX2) damageX2 = x2;
+
+		for(uint8_t i = 0; i < pages; i++) {
+			oled.MarkDirty(page + i, x1, x2);
+		}
+	}
+
+	public:
+
+	OLED_SSD1306_Damage GetDamage();
+	bool Render();
+};
+
+
+
+/**
+ * \brief A fixed width line of text, only characters that differ from the last text are redrawn
+ */
+class OLED_SSD1306_Label : public OLED_SSD1306_Widget {
+	private:
+
+	const char* fontSheet;
+	uint8_t fontSheetCharacterLength;
+	char text[OLED_WIDGET_LABEL_MAX];
+
+	protected:
+
+	///Characters in the box, after clipping to OLED_WIDGET_LABEL_MAX and the screen
+	uint8_t length;
+
+	public:
+
+	OLED_SSD1306_Label(OLED_SSD1306& newOled, uint8_t x, uint8_t newPage, uint8_t newLength, const char newFontSheet[], uint8_t newFontSheetCharacterLength);
+
+	void SetText(const char* s);
+};
+
+
+
+/**
+ * \brief A right aligned number, formatting is skipped when the value has not changed
+ */
+class OLED_SSD1306_Number : public OLED_SSD1306_Label {
+	private:
+
+	int32_t value;
+	bool valid;
+	uint8_t digits;
+
+	public:
+
+	OLED_SSD1306_Number(OLED_SSD1306& newOled, uint8_t x, uint8_t newPage, uint8_t newDigits, const char newFontSheet[], uint8_t newFontSheetCharacterLength);
+
+	void SetValue(int32_t newValue);
+};
+
+
+
+/**
+ * \brief A horizontal bar gauge with end caps, only the columns between the old and new fill are redrawn
+ */
+class OLED_SSD1306_Bar : public OLED_SSD1306_Widget {
+	private:
+
+	///Filled inner columns, 0xFF before the first draw
+	uint8_t filled;
+
+	void DrawColumns(uint8_t first, uint8_t last, bool fill);
+
+	public:
+
+	OLED_SSD1306_Bar(OLED_SSD1306& newOled, uint8_t x, uint8_t newPage, uint8_t newWidth, uint8_t newPages);
+
+	void SetValue(uint16_t newValue, uint16_t maximum);
+};
+
+
+
+/**
+ * \brief A page major progmem bitmap, redrawn only when a different bitmap is set
+ */
+class OLED_SSD1306_Icon : public OLED_SSD1306_Widget {
+	private:
+
+	const uint8_t* bitmap;
+	bool drawn;
+
+	///Bytes in each page of the bitmap, the width asked for before clipping
+	uint8_t stride;
+
+	public:
+
+	OLED_SSD1306_Icon(OLED_SSD1306& newOled, uint8_t x, uint8_t newPage, uint8_t newWidth, uint8_t newPages);
+
+	void SetBitmap(const uint8_t* newBitmap);
+};
+
+
+
+#endif
+#endif
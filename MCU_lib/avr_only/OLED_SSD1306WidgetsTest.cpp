@@ -0,0 +1,217 @@
+/**
+ * \file OLED_SSD1306WidgetsTest.cpp
+ * \author Tim Robbins
+ * \brief Host side checks of the widgets in OLED_SSD1306Widgets.h against the panel emulator. \n
+ * Prints each check that fails and returns the number of them. \n
+ * BUILD AND RUN, from this folder: \n
+ * gcc -std=gnu11 -DSSD1306_SIM=1 -I.. -c ../ssd1306Sim.c ../font.c && g++ -fsanitize=address,undefined -DSSD1306_SIM=1 -I.. OLED_SSD1306WidgetsTest.cpp OLED_SSD1306.cpp OLED_SSD1306Widgets.cpp ssd1306Sim.o font.o -o widgetsTest && ./widgetsTest
+ */
+#include "OLED_SSD1306Widgets.h"
+
+#if defined(__cplusplus) && defined(SSD1306_SIM) && SSD1306_SIM == 1 && !defined(__NO_INCLUDE_OLED_CPP)
+
+#include <stdio.h>
+
+///Control port pins of the emulated display, the data/command and reset pins are where the emulator reads them
+#define WIDGETS_TEST_CS_PIN			7
+
+static int widgetsTestFailures = 0;
+
+
+
+/**
+ * \brief Counts and prints a failed check
+ * \param passed -If the check passed
+ * \param what	 -What was checked
+ */
+static void WidgetsTestCheck(bool passed, const char* what) {
+	if(!passed) {
+		printf("FAIL: %s\n", what);
+		widgetsTestFailures++;
+	}
+}
+
+
+
+/**
+ * \brief Gets if every byte of the rows is 0
+ * \param rows	 -The rows
+ * \param pages	 -The number of rows
+ * \return true if blank
+ */
+static bool WidgetsTestBlank(uint8_t rows[][128], uint8_t pages) {
+	for(uint8_t i = 0; i < pages; i++) {
+		for(uint8_t x = 0; x < 128; x++) {
+			if(rows[i][x]) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+
+
+/**
+ * \brief A numeric field narrower than one character is clipped to no digits and draws nothing
+ */
+static void WidgetsTestZeroWidthNumber() {
+	static uint8_t buffer[8][128];
+	OLED_SSD1306 oled(&ssd1306SimConPort, WIDGETS_TEST_CS_PIN, SSD1306_DC_PIN_POSITION, SSD1306_RES_PIN_POSITION, true, SSD1306_NORMALSIZE, buffer);
+	oled.Initialize(true, 128, 64);
+	oled.ClearBuffer();
+
+	//2 columns left at x=126, a 6 column font doesn't fit
+	OLED_SSD1306_Number field(oled, 126, 0, 4, ssd1306oled_font_A, ssd1306oled_font_A_char_length);
+	field.SetValue(1234);
+	field.SetValue(-5);
+
+	WidgetsTestCheck(WidgetsTestBlank(buffer, 8), "zero width number leaves the buffer alone");
+	WidgetsTestCheck(!field.Render(), "zero width number has nothing to render");
+}
+
+
+
+/**
+ * \brief Widgets below a 128x32 screen draw nothing, its caller owned buffer only has the 4 pages the screen needs
+ */
+static void WidgetsTestOffScreen() {
+	//Pages 4 to 7 stand for whatever is after the 4 page buffer
+	static uint8_t buffer[8][128];
+	static const uint8_t icon[16] = {0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF};
+	OLED_SSD1306 oled(&ssd1306SimConPort, WIDGETS_TEST_CS_PIN, SSD1306_DC_PIN_POSITION, SSD1306_RES_PIN_POSITION, true, SSD1306_NORMALSIZE, buffer);
+	oled.Initialize(true, 128, 32);
+	oled.ClearBuffer();
+
+	OLED_SSD1306_Label label(oled, 0, 4, 8, ssd1306oled_font_A, ssd1306oled_font_A_char_length);
+	OLED_SSD1306_Label farLabel(oled, 0, 8, 8, ssd1306oled_font_A, ssd1306oled_font_A_char_length);
+	OLED_SSD1306_Number number(oled, 0, 6, 4, ssd1306oled_font_A, ssd1306oled_font_A_char_length);
+	OLED_SSD1306_Bar bar(oled, 0, 9, 64, 2);
+	OLED_SSD1306_Icon iconWidget(oled, 0, 5, 8, 2);
+	OLED_SSD1306_Bar offRight(oled, 200, 0, 64, 1);
+
+	label.SetText("Hello");
+	farLabel.SetText("Hello");
+	number.SetValue(42);
+	bar.SetValue(5, 10);
+	iconWidget.SetBitmap(icon);
+	offRight.SetValue(5, 10);
+
+	WidgetsTestCheck(WidgetsTestBlank(buffer, 8), "off screen widgets leave the buffer alone");
+	WidgetsTestCheck(!label.Render() && !farLabel.Render() && !number.Render() && !bar.Render() && !iconWidget.Render() && !offRight.Render(),
+		"off screen widgets have nothing to render");
+}
+
+
+
+/**
+ * \brief An icon clipped at the right edge still reads each page of its bitmap at the full width
+ */
+static void WidgetsTestClippedIcon() {
+	static uint8_t buffer[8][128];
+	static uint8_t icon[32];
+	OLED_SSD1306 oled(&ssd1306SimConPort, WIDGETS_TEST_CS_PIN, SSD1306_DC_PIN_POSITION, SSD1306_RES_PIN_POSITION, true, SSD1306_NORMALSIZE, buffer);
+	oled.Initialize(true, 128, 64);
+	oled.ClearBuffer();
+
+	for(uint8_t i = 0; i < 32; i++) {
+		icon[i] = i + 1;
+	}
+
+	OLED_SSD1306_Icon iconWidget(oled, 120, 2, 16, 2);
+	iconWidget.SetBitmap(icon);
+
+	WidgetsTestCheck(buffer[2][120] == 1 && buffer[2][127] == 8 && buffer[3][120] == 17 && buffer[3][127] == 24, "clipped icon keeps the bitmap's stride");
+}
+
+
+
+/**
+ * \brief Widgets drawn alongside other drawing are sent by Update() without Render()
+ */
+static void WidgetsTestUpdateSendsWidgets() {
+	static uint8_t buffer[8][128];
+	OLED_SSD1306 oled(&ssd1306SimConPort, WIDGETS_TEST_CS_PIN, SSD1306_DC_PIN_POSITION, SSD1306_RES_PIN_POSITION, true, SSD1306_NORMALSIZE, buffer);
+	oled.Initialize(true, 128, 64);
+	oled.ClearBuffer();
+	oled.Update();
+
+	OLED_SSD1306_Label label(oled, 10, 1, 6, ssd1306oled_font_A, ssd1306oled_font_A_char_length);
+	OLED_SSD1306_Bar bar(oled, 0, 4, 100, 2);
+
+	label.SetText("Speed");
+	bar.SetValue(30, 100);
+	oled.DrawLine(0, 63, 127, 63, SSD1306_WHITE);
+	oled.Update();
+
+	bool matches = true;
+
+	for(uint8_t i = 0; i < 8; i++) {
+		matches = matches && memcmp(SSD1306SimGetPage(0, i), buffer[i], 128) == 0;
+	}
+
+	WidgetsTestCheck(!WidgetsTestBlank(buffer, 8), "widgets drew into the buffer");
+	WidgetsTestCheck(matches, "Update sends widget changes");
+}
+
+
+
+/**
+ * \brief Setting an unchanged value sends nothing, changing one digit sends one glyph
+ */
+static void WidgetsTestDigitTraffic() {
+	static uint8_t buffer[8][128];
+	OLED_SSD1306 oled(&ssd1306SimConPort, WIDGETS_TEST_CS_PIN, SSD1306_DC_PIN_POSITION, SSD1306_RES_PIN_POSITION, true, SSD1306_NORMALSIZE, buffer);
+	oled.Initialize(true, 128, 64);
+	oled.ClearBuffer();
+
+	OLED_SSD1306_Number field(oled, 0, 0, 4, ssd1306oled_font_A, ssd1306oled_font_A_char_length);
+	field.SetValue(1234);
+	field.Render();
+	oled.Update();
+
+	SSD1306SimResetStats();
+	field.SetValue(1234);
+	OLED_SSD1306_Damage damage = field.GetDamage();
+	field.Render();
+	oled.Update();
+
+	WidgetsTestCheck(damage.x1 > damage.x2, "unchanged value leaves no damage");
+	WidgetsTestCheck(SSD1306SimGetStats().dataBytes == 0, "unchanged value sends no data");
+
+	//The last digit is the 4th character, columns 18 to 23
+	field.SetValue(1235);
+	damage = field.GetDamage();
+
+	WidgetsTestCheck(damage.x1 == 3 * ssd1306oled_font_A_char_length && damage.x2 == 4 * ssd1306oled_font_A_char_length - 1 && damage.page1 == 0 && damage.page2 == 0,
+		"one digit change damages one glyph");
+
+	SSD1306SimResetStats();
+	field.Render();
+	WidgetsTestCheck(SSD1306SimGetStats().dataBytes == ssd1306oled_font_A_char_length, "Render sends one glyph for one digit");
+
+	SSD1306SimResetStats();
+	oled.Update();
+	WidgetsTestCheck(SSD1306SimGetStats().dataBytes == ssd1306oled_font_A_char_length, "Update sends one glyph for one digit");
+}
+
+
+
+int main() {
+	//Chip select of panel 0 held low, the emulator reads data/command from ssd1306SimConPort
+	ssd1306SimCsPorts[0] = 0xFE;
+	SSD1306SimReset();
+
+	WidgetsTestZeroWidthNumber();
+	WidgetsTestOffScreen();
+	WidgetsTestClippedIcon();
+	WidgetsTestUpdateSendsWidgets();
+	WidgetsTestDigitTraffic();
+
+	printf("%d failed\n", widgetsTestFailures);
+
+	return widgetsTestFailures;
+}
+
+#endif
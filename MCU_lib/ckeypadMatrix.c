@@ -8,6 +8,51 @@
 #if !defined(__CKEYPADMATRIX_C__) && defined(__INCLUDED_CKEYPADMATRIX__)
 #define __CKEYPADMATRIX_C__	1
 
+///Bit of each column pin, set by kp_Init
+static uint8_t m_auchrKpColumnBits[KP_COLUMNS];
+
+///Bit of each row pin, set by kp_Init
+static uint8_t m_auchrKpRowBits[KP_ROWS];
+
+///Masks for every column and every row pin, set by kp_Init
+static uint8_t m_uchrKpColumnMask = 0;
+static uint8_t m_uchrKpRowMask = 0;
+
+#if KP_USE_EVENTS == 1
+#include <string.h>
+
+///Timer 1 compare match count for KP_EVENT_TICK_MS with a prescaler of 64
+#define KP_EVENT_TIMER_TOP	(F_CPU / 64UL * KP_EVENT_TICK_MS / 1000UL - 1)
+
+#if KP_EVENT_TIMER_TOP > 0xFFFF
+#error ckeypadMatrix.c: KP_EVENT_TICK_MS is too long for timer 1 at this F_CPU.
+#endif
+
+///Keypad values of the keys, set by kp_Events_Init
+static const unsigned char (*m_puchrKpValues)[KP_COLUMNS] = 0;
+
+///Debounce count of each key, up while it reads down and down while it reads up
+static uint8_t m_auchrKpDebounce[KP_ROWS][KP_COLUMNS];
+
+///Scans each key has been held since its press event
+static uint16_t m_aushtKpHeld[KP_ROWS][KP_COLUMNS];
+
+///Debounced state of the keys, bit i of byte j for the key in column i of row j
+static uint8_t m_auchrKpDown[KP_ROWS];
+
+static volatile kp_event_t m_aKpEvents[KP_EVENT_QUEUE_SIZE];
+static volatile uint8_t m_uchrKpEventHead = 0;
+static volatile uint8_t m_uchrKpEventTail = 0;
+#endif
+
+#if KP_USE_PIN_CHANGE_WAKE == 1
+///Set by the row pins' pin change interrupt, cleared once a scan finds every key let go
+static volatile bool m_bKpAwake = false;
+
+///The rows armed by kp_Idle
+static volatile uint8_t m_uchrKpWakeRowMask = 0;
+#endif
+
 
 /**
 * \brief Gets a keypad value from the const 2D array passed and constant pin values
@@ -269,6 +314,395 @@ unsigned char uchrRowPinPositions[KP_ROWS], unsigned char uchrKeypadValues[KP_RO
 
 
 
+/**
+* \brief Works out the pin masks for kp_Scan_matrix and sets the columns and rows as inputs pulled up
+* \param uchrColumnPinPositions The column pins
+* \param uchrRowPinPositions The row pins
+*/
+void kp_Init(const unsigned char uchrColumnPinPositions[KP_COLUMNS], const unsigned char uchrRowPinPositions[KP_ROWS])
+{
+	uint8_t i = 0; //index
+	
+	m_uchrKpColumnMask = 0;
+	m_uchrKpRowMask = 0;
+	
+	for(i = 0; i < KP_COLUMNS; i++)
+	{
+		m_auchrKpColumnBits[i] = (1 << uchrColumnPinPositions[i]);
+		m_uchrKpColumnMask |= m_auchrKpColumnBits[i];
+	}
+	
+	for(i = 0; i < KP_ROWS; i++)
+	{
+		m_auchrKpRowBits[i] = (1 << uchrRowPinPositions[i]);
+		m_uchrKpRowMask |= m_auchrKpRowBits[i];
+	}
+	
+	//Input pull up, only the column being read is driven so pressed keys never short two outputs
+	writeMaskInput(KP_COLUMN_DIR, m_uchrKpColumnMask);
+	KP_COLUMN_PORT |= m_uchrKpColumnMask;
+	
+	writeMaskInput(KP_ROW_DIR, m_uchrKpRowMask);
+	KP_ROW_PORT |= m_uchrKpRowMask;
+}
+
+
+
+/**
+* \brief Reads every key of the keypad in one pass, kp_Init must be called first
+* \param auchrKeys Filled with a byte for each row, bit i set when the key in column i is down
+* \return true if three pressed keys on the corners of a rectangle may be showing a fourth that isn't pressed
+*/
+bool kp_Scan_matrix(uint8_t auchrKeys[KP_ROWS])
+{
+	//Variables
+	uint8_t i = 0; //column index
+	uint8_t j = 0; //row index
+	uint8_t k = 0; //other row index
+	uint8_t currentRowPress = 0; //The row pins pulled low
+	uint8_t sharedColumns = 0; //Columns pressed in two rows
+	
+	for(j = 0; j < KP_ROWS; j++)
+	{
+		auchrKeys[j] = 0;
+	}
+	
+	//Loop through and check for columns
+	for(i = 0; i < KP_COLUMNS; i++)
+	{
+		//Set current pin
+		KP_COLUMN_PORT &= ~m_auchrKpColumnBits[i];
+		writeMaskOutput(KP_COLUMN_DIR, m_auchrKpColumnBits[i]);
+		
+		//Slight delay for time to take affect
+		delayForMicroseconds(1);
+		
+		//Read the value on the row pins, low for each key down in this column
+		currentRowPress = ~KP_ROW_READ & m_uchrKpRowMask;
+		
+		//Reset current pin
+		writeMaskInput(KP_COLUMN_DIR, m_auchrKpColumnBits[i]);
+		KP_COLUMN_PORT |= m_auchrKpColumnBits[i];
+		
+		if(currentRowPress)
+		{
+			for(j = 0; j < KP_ROWS; j++)
+			{
+				if(currentRowPress & m_auchrKpRowBits[j])
+				{
+					auchrKeys[j] |= (1 << i);
+				}
+			}
+		}
+	}
+	
+	//Two rows with two or more columns in common are a rectangle
+	for(j = 0; j < KP_ROWS; j++)
+	{
+		for(k = j + 1; k < KP_ROWS; k++)
+		{
+			sharedColumns = auchrKeys[j] & auchrKeys[k];
+			
+			if(sharedColumns & (sharedColumns - 1))
+			{
+				return true;
+			}
+		}
+	}
+	
+	return false;
+}
+
+
+
+/**
+* \brief Gets the keypad value of the first key down in a bitmap from kp_Scan_matrix, in the same order kp_Scan finds them
+* \param auchrKeys The bitmap
+* \param uchrKeypadValues The keypad array
+* \return The key pressed, if any from the keypad array
+*/
+uint8_t kp_Matrix_Key(const uint8_t auchrKeys[KP_ROWS], const unsigned char uchrKeypadValues[KP_ROWS][KP_COLUMNS])
+{
+	uint8_t i = 0; //column index
+	uint8_t j = 0; //row index
+	
+	for(i = 0; i < KP_COLUMNS; i++)
+	{
+		for(j = 0; j < KP_ROWS; j++)
+		{
+			if(auchrKeys[j] & (1 << i))
+			{
+				return uchrKeypadValues[j][i];
+			}
+		}
+	}
+	
+	return '\0';
+}
+
+
+
+#if KP_USE_PIN_CHANGE_WAKE == 1
+
+/**
+* \brief A row pin changed, flags the keypad as awake and disarms the rows so scanning doesn't interrupt
+*/
+ISR(KP_ROW_PCINT_VECT)
+{
+	KP_ROW_PCINT_MASK &= ~m_uchrKpWakeRowMask;
+	m_bKpAwake = true;
+}
+
+
+
+/**
+* \brief Drives every column low with the rows pulled up and arms the rows' pin change interrupt, so the MCU can sleep until a key is pressed
+* \param uchrColumnPinPositions The column pins
+* \param uchrRowPinPositions The row pins, all in the KP_ROW_PCINT_VECT group
+*/
+void kp_Idle(const unsigned char uchrColumnPinPositions[KP_COLUMNS], const unsigned char uchrRowPinPositions[KP_ROWS])
+{
+	//Variables
+	uint8_t i = 0; //index
+	uint8_t columnMask = 0; //Mask for the column pins
+	uint8_t rowMask = 0; //Mask for the row pins
+	
+	for(i = 0; i < KP_COLUMNS; i++)
+	{
+		columnMask |= (1 << uchrColumnPinPositions[i]);
+	}
+	
+	for(i = 0; i < KP_ROWS; i++)
+	{
+		rowMask |= (1 << uchrRowPinPositions[i]);
+	}
+	
+	//Columns low, so any key pulls its row down
+	KP_COLUMN_PORT &= ~columnMask;
+	writeMaskOutput(KP_COLUMN_DIR, columnMask);
+	
+	//Input pull up
+	writeMaskInput(KP_ROW_DIR, rowMask);
+	KP_ROW_PORT |= rowMask;
+	
+	//Slight delay for time to take affect
+	delayForMicroseconds(1);
+	
+	//Drop any change from setting up the pins, then arm the rows
+	m_uchrKpWakeRowMask = rowMask;
+	m_bKpAwake = false;
+	PCIFR = (1 << KP_ROW_PCINT_ENABLE);
+	KP_ROW_PCINT_MASK |= rowMask;
+	PCICR |= (1 << KP_ROW_PCINT_ENABLE);
+	
+	//A key already down won't make a change, so check for one
+	if((KP_ROW_READ & rowMask) != rowMask)
+	{
+		KP_ROW_PCINT_MASK &= ~rowMask;
+		m_bKpAwake = true;
+	}
+}
+
+
+
+/**
+* \brief Gets if a key went down since kp_Idle
+* \return true if the keypad needs scanning
+*/
+bool kp_Is_Awake()
+{
+	return m_bKpAwake;
+}
+
+
+
+/**
+* \brief Gets a keypad value like kp_Scan_const, but only scans once a row pin changed after kp_Idle. \n
+* Goes back to idle when no key is found, so it can be called after each wake from sleep. kp_Idle must be called once first.
+* \return The key pressed, if any from the keypad array
+*/
+uint8_t kp_Scan_wake(const unsigned char uchrColumnPinPositions[KP_COLUMNS],
+const unsigned char uchrRowPinPositions[KP_ROWS], const unsigned char uchrKeypadValues[KP_ROWS][KP_COLUMNS])
+{
+	uint8_t pressedValue = '\0'; //The return value for the entered value
+	
+	//Nothing pressed since idle, nothing to scan
+	if(!m_bKpAwake)
+	{
+		return pressedValue;
+	}
+	
+	//Scanning changes the rows, keep the interrupt out of it
+	KP_ROW_PCINT_MASK &= ~m_uchrKpWakeRowMask;
+	
+	pressedValue = kp_Scan_const(uchrColumnPinPositions, uchrRowPinPositions, uchrKeypadValues);
+	
+	//Stay awake while a key is held, back to idle once it is let go
+	if(pressedValue == '\0')
+	{
+		kp_Idle(uchrColumnPinPositions, uchrRowPinPositions);
+	}
+	
+	return pressedValue;
+}
+
+#endif
+
+
+
+#if KP_USE_EVENTS == 1
+
+/**
+* \brief Puts an event at the head of the queue, dropping it if the queue is full
+* \param uchrKey The keypad value
+* \param uchrType The KP_EVENT_ type
+*/
+static void kp_Post_Event(unsigned char uchrKey, uint8_t uchrType)
+{
+	uint8_t uchrNextHead = (m_uchrKpEventHead + 1 >= KP_EVENT_QUEUE_SIZE) ? 0 : m_uchrKpEventHead + 1;
+	
+	//Full, the main loop hasn't kept up
+	if(uchrNextHead == m_uchrKpEventTail)
+	{
+		return;
+	}
+	
+	m_aKpEvents[m_uchrKpEventHead].uchrKey = uchrKey;
+	m_aKpEvents[m_uchrKpEventHead].uchrType = uchrType;
+	m_uchrKpEventHead = uchrNextHead;
+}
+
+
+
+/**
+* \brief Timer 1 compare A interrupt. Scans the keypad, moves each key's debounce count toward what it reads,
+* and posts an event when a key's debounced state changes or it has been held long enough to long press or repeat.
+*/
+ISR(TIMER1_COMPA_vect)
+{
+	uint8_t auchrKeys[KP_ROWS]; //Keys read down this scan
+	uint8_t i = 0; //column index
+	uint8_t j = 0; //row index
+	
+	//A ghost could press a key that isn't there, wait for a clean scan
+	if(kp_Scan_matrix(auchrKeys))
+	{
+		return;
+	}
+	
+	for(j = 0; j < KP_ROWS; j++)
+	{
+		for(i = 0; i < KP_COLUMNS; i++)
+		{
+			if(auchrKeys[j] & (1 << i))
+			{
+				if(m_auchrKpDebounce[j][i] < KP_DEBOUNCE_TICKS)
+				{
+					m_auchrKpDebounce[j][i]++;
+				}
+			}
+			else if(m_auchrKpDebounce[j][i] > 0)
+			{
+				m_auchrKpDebounce[j][i]--;
+			}
+			
+			if(!(m_auchrKpDown[j] & (1 << i)))
+			{
+				if(m_auchrKpDebounce[j][i] >= KP_DEBOUNCE_TICKS)
+				{
+					m_auchrKpDown[j] |= (1 << i);
+					m_aushtKpHeld[j][i] = 0;
+					kp_Post_Event(m_puchrKpValues[j][i], KP_EVENT_PRESS);
+				}
+			}
+			else if(m_auchrKpDebounce[j][i] == 0)
+			{
+				m_auchrKpDown[j] &= ~(1 << i);
+				kp_Post_Event(m_puchrKpValues[j][i], KP_EVENT_RELEASE);
+			}
+			else if(m_aushtKpHeld[j][i] < 0xFFFF)
+			{
+				m_aushtKpHeld[j][i]++;
+				
+				if(m_aushtKpHeld[j][i] == KP_LONG_PRESS_TICKS)
+				{
+					kp_Post_Event(m_puchrKpValues[j][i], KP_EVENT_LONG_PRESS);
+				}
+				#if KP_REPEAT_TICKS > 0
+				else if(m_aushtKpHeld[j][i] == (uint16_t)(KP_LONG_PRESS_TICKS + KP_REPEAT_TICKS))
+				{
+					//Count the next repeat from the long press again
+					m_aushtKpHeld[j][i] = KP_LONG_PRESS_TICKS;
+					kp_Post_Event(m_puchrKpValues[j][i], KP_EVENT_REPEAT);
+				}
+				#endif
+			}
+		}
+	}
+}
+
+
+
+/**
+* \brief Sets up the keypad with kp_Init and starts timer 1 scanning it every KP_EVENT_TICK_MS. Global interrupts must be on for events to come.
+* \param uchrColumnPinPositions The column pins
+* \param uchrRowPinPositions The row pins
+* \param uchrKeypadValues The keypad array, kept for the events so it must stay in scope
+*/
+void kp_Events_Init(const unsigned char uchrColumnPinPositions[KP_COLUMNS],
+const unsigned char uchrRowPinPositions[KP_ROWS], const unsigned char uchrKeypadValues[KP_ROWS][KP_COLUMNS])
+{
+	uint8_t uchrSREG = SREG; //Interrupt state to put back
+	
+	cli();
+	
+	kp_Init(uchrColumnPinPositions, uchrRowPinPositions);
+	
+	m_puchrKpValues = uchrKeypadValues;
+	memset(m_auchrKpDebounce, 0x00, sizeof(m_auchrKpDebounce));
+	memset(m_aushtKpHeld, 0x00, sizeof(m_aushtKpHeld));
+	memset(m_auchrKpDown, 0x00, sizeof(m_auchrKpDown));
+	m_uchrKpEventHead = 0;
+	m_uchrKpEventTail = 0;
+	
+	//CTC on OCR1A, prescaler of 64
+	TCCR1B = 0;
+	TCCR1A = 0;
+	TCNT1 = 0;
+	OCR1A = KP_EVENT_TIMER_TOP;
+	TIFR1 = (1 << OCF1A);
+	TIMSK1 |= (1 << OCIE1A);
+	TCCR1B = (1 << WGM12) | (1 << CS11) | (1 << CS10);
+	
+	SREG = uchrSREG;
+}
+
+
+
+/**
+* \brief Takes the oldest event from the queue
+* \param pEvent Filled with the event, if there is one
+* \return true if there was an event
+*/
+bool kp_Get_Event(kp_event_t* pEvent)
+{
+	//Only the interrupt moves the head
+	if(m_uchrKpEventTail == m_uchrKpEventHead)
+	{
+		return false;
+	}
+	
+	pEvent->uchrKey = m_aKpEvents[m_uchrKpEventTail].uchrKey;
+	pEvent->uchrType = m_aKpEvents[m_uchrKpEventTail].uchrType;
+	m_uchrKpEventTail = (m_uchrKpEventTail + 1 >= KP_EVENT_QUEUE_SIZE) ? 0 : m_uchrKpEventTail + 1;
+	
+	return true;
+}
+
+#endif
+
+
+
 
 
 
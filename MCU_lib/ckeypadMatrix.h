@@ -5,7 +5,19 @@
  * \version v2.0
  * REQUIREMENTS: \n
  * "config.h", "mcuUtils.h", and "mcuDelays.h" must be included. \n
- * KP_COLUMN_PORT, KP_COLUMN_READ, KP_COLUMN_DIR, KP_ROW_PORT, KP_ROW_READ, KP_ROW_DIR. Previous separate masks were required to be defined but it was a confusing waste.
+ * KP_COLUMN_PORT, KP_COLUMN_READ, KP_COLUMN_DIR, KP_ROW_PORT, KP_ROW_READ, KP_ROW_DIR. Previous separate masks were required to be defined but it was a confusing waste. \n
+ * kp_Init and kp_Scan_matrix read every key at once for chords, kp_Init works out the pin masks once and kp_Scan_matrix then reads the rows \n
+ * once for each column into a bitmap of KP_ROWS bytes, bit i of byte j set when the key in column i of row j is down. \n
+ * Without a diode on each key, three keys on the corners of a rectangle also show the fourth, kp_Scan_matrix returns true when that could have happened. \n
+ * Defining KP_USE_PIN_CHANGE_WAKE as 1 on AVR adds kp_Idle and kp_Scan_wake for keypads that sit unpressed most of the time. \n
+ * kp_Idle drives every column low and arms the pin change interrupt of the row pins, the interrupt flags the change and disarms itself, \n
+ * so the MCU can sleep until a key goes down. kp_Scan_wake returns straight away until then, and goes back to idle once every key is let go. \n
+ * The row pins must all be in the pin change group given by KP_ROW_PCINT_VECT, KP_ROW_PCINT_MASK, and KP_ROW_PCINT_ENABLE, \n
+ * for example PCINT_16_TO_23_VECT, PCINT_16_TO_23_MASK, and PCIE2 from "mcuPinUtils.h" for port D of an ATmega328P. The vector belongs to the keypad. \n
+ * Defining KP_USE_EVENTS as 1 on AVR adds kp_Events_Init and kp_Get_Event. Timer 1 compare A then runs kp_Scan_matrix every KP_EVENT_TICK_MS, \n
+ * counts each key up while it reads down and back while it reads up, and only takes a key as pressed or released once its count reaches KP_DEBOUNCE_TICKS or 0. \n
+ * Press, release, long press and repeat events go into a ring of KP_EVENT_QUEUE_SIZE events for the main loop to take with kp_Get_Event. \n
+ * Scans that could be ghosting are skipped. Global interrupts must be on, and timer 1 and the keypad pins belong to the interrupt, so kp_Scan_wake can't be used alongside it.
  */
 #include "config.h"
 
@@ -45,6 +57,7 @@ extern "C" {
 
 #include "mcuUtils.h"
 #include "mcuDelays.h"
+#include <stdbool.h>
 
 #ifndef KP_COLUMN_PORT
 //#warning ckeypadMatrix.h: KP_COLUMN_PORT must be defined as the ports output register to use
@@ -97,6 +110,79 @@ extern "C" {
 #define KP_ROWS	                4
 #endif
 
+//Sleep between key presses on the row pins' pin change interrupt instead of scanning continuously
+#ifndef KP_USE_PIN_CHANGE_WAKE
+#define KP_USE_PIN_CHANGE_WAKE  0
+#endif
+
+//Pin change interrupts are only on AVR
+#if KP_USE_PIN_CHANGE_WAKE == 1 && !defined(__AVR)
+    #warning ckeypadMatrix.h: KP_USE_PIN_CHANGE_WAKE needs an AVR target, kp_Idle and kp_Scan_wake are not included.
+    #undef KP_USE_PIN_CHANGE_WAKE
+    #define KP_USE_PIN_CHANGE_WAKE 0
+#endif
+
+//Debounce each key and queue its events from the timer 1 compare A interrupt, so the main loop doesn't scan or wait
+#ifndef KP_USE_EVENTS
+#define KP_USE_EVENTS           0
+#endif
+
+//Milliseconds between scans of the event service
+#ifndef KP_EVENT_TICK_MS
+#define KP_EVENT_TICK_MS        5
+#endif
+
+//Scans in a row a key has to read down, or up, before it counts as pressed, or released
+#ifndef KP_DEBOUNCE_TICKS
+#define KP_DEBOUNCE_TICKS       4
+#endif
+
+//Scans a key is held after its press event before the long press event
+#ifndef KP_LONG_PRESS_TICKS
+#define KP_LONG_PRESS_TICKS     200
+#endif
+
+//Scans between repeat events once a key has long pressed, 0 for no repeats
+#ifndef KP_REPEAT_TICKS
+#define KP_REPEAT_TICKS         20
+#endif
+
+//Events the queue holds, up to 255, new events are dropped while it is full
+#ifndef KP_EVENT_QUEUE_SIZE
+#define KP_EVENT_QUEUE_SIZE     16
+#endif
+
+//The event service needs the AVR timer interrupt
+#if KP_USE_EVENTS == 1 && !defined(__AVR)
+    #warning ckeypadMatrix.h: KP_USE_EVENTS needs an AVR target, kp_Events_Init and kp_Get_Event are not included.
+    #undef KP_USE_EVENTS
+    #define KP_USE_EVENTS 0
+#endif
+
+//Idling drives the columns low under the event service's scans
+#if KP_USE_EVENTS == 1 && KP_USE_PIN_CHANGE_WAKE == 1
+    #warning ckeypadMatrix.h: KP_USE_EVENTS scans the keypad from its timer, KP_USE_PIN_CHANGE_WAKE is disabled.
+    #undef KP_USE_PIN_CHANGE_WAKE
+    #define KP_USE_PIN_CHANGE_WAKE 0
+#endif
+
+#if KP_USE_EVENTS == 1 || KP_USE_PIN_CHANGE_WAKE == 1
+#include <avr/interrupt.h>
+#endif
+
+#if KP_USE_PIN_CHANGE_WAKE == 1
+
+#include "mcuPinUtils.h"
+
+//The vector, mask register, and PCICR enable bit of the pin change group holding the row pins
+#if !defined(KP_ROW_PCINT_VECT) || !defined(KP_ROW_PCINT_MASK) || !defined(KP_ROW_PCINT_ENABLE)
+    #warning ckeypadMatrix.h: KP_USE_PIN_CHANGE_WAKE needs KP_ROW_PCINT_VECT, KP_ROW_PCINT_MASK, and KP_ROW_PCINT_ENABLE, kp_Idle and kp_Scan_wake are not included.
+    #undef KP_USE_PIN_CHANGE_WAKE
+    #define KP_USE_PIN_CHANGE_WAKE 0
+#endif
+
+#endif
+
 
 extern uint8_t kp_Scan_const(const unsigned char uchrColumnPinPositions[KP_COLUMNS],
 const unsigned char uchrRowPinPositions[KP_ROWS], const unsigned char uchrKeypadValues[KP_ROWS][KP_COLUMNS]);
@@ -104,6 +190,39 @@ const unsigned char uchrRowPinPositions[KP_ROWS], const unsigned char uchrKeypad
 extern uint8_t kp_Scan(unsigned char uchrColumnPinPositions[KP_COLUMNS],
 unsigned char uchrRowPinPositions[KP_ROWS], unsigned char uchrKeypadValues[KP_ROWS][KP_COLUMNS]);
 
+extern void kp_Init(const unsigned char uchrColumnPinPositions[KP_COLUMNS], const unsigned char uchrRowPinPositions[KP_ROWS]);
+
+extern bool kp_Scan_matrix(uint8_t auchrKeys[KP_ROWS]);
+
+extern uint8_t kp_Matrix_Key(const uint8_t auchrKeys[KP_ROWS], const unsigned char uchrKeypadValues[KP_ROWS][KP_COLUMNS]);
+
+#if KP_USE_EVENTS == 1
+#define KP_EVENT_PRESS          1
+#define KP_EVENT_RELEASE        2
+#define KP_EVENT_LONG_PRESS     3
+#define KP_EVENT_REPEAT         4
+
+///An event from the event service, uchrKey is the keypad value and uchrType one of the KP_EVENT_ values
+typedef struct
+{
+	unsigned char uchrKey;
+	uint8_t uchrType;
+} kp_event_t;
+
+extern void kp_Events_Init(const unsigned char uchrColumnPinPositions[KP_COLUMNS],
+const unsigned char uchrRowPinPositions[KP_ROWS], const unsigned char uchrKeypadValues[KP_ROWS][KP_COLUMNS]);
+
+extern bool kp_Get_Event(kp_event_t* pEvent);
+#endif
+
+#if KP_USE_PIN_CHANGE_WAKE == 1
+extern void kp_Idle(const unsigned char uchrColumnPinPositions[KP_COLUMNS], const unsigned char uchrRowPinPositions[KP_ROWS]);
+
+extern bool kp_Is_Awake();
+
+extern uint8_t kp_Scan_wake(const unsigned char uchrColumnPinPositions[KP_COLUMNS],
+const unsigned char uchrRowPinPositions[KP_ROWS], const unsigned char uchrKeypadValues[KP_ROWS][KP_COLUMNS]);
+#endif
 
 
 #else
@@ -8,6 +8,52 @@
 #if !defined(CLCD_C) && defined(__INCLUDED_CLCD__)
 #define CLCD_C 1
 
+#if LCD_USE_QUEUE == 1
+
+#include <avr/interrupt.h>
+
+///Timer 2 clock select bits for LCD_QUEUE_PRESCALER
+#if LCD_QUEUE_PRESCALER == 8
+#define LCD_QUEUE_CLOCK_SELECT	(1 << CS21)
+#elif LCD_QUEUE_PRESCALER == 32
+#define LCD_QUEUE_CLOCK_SELECT	(1 << CS21 | 1 << CS20)
+#elif LCD_QUEUE_PRESCALER == 64
+#define LCD_QUEUE_CLOCK_SELECT	(1 << CS22)
+#elif LCD_QUEUE_PRESCALER == 128
+#define LCD_QUEUE_CLOCK_SELECT	(1 << CS22 | 1 << CS20)
+#elif LCD_QUEUE_PRESCALER == 256
+#define LCD_QUEUE_CLOCK_SELECT	(1 << CS22 | 1 << CS21)
+#else
+#error clcd.c: LCD_QUEUE_PRESCALER must be 8, 32, 64, 128 or 256
+#endif
+
+///Timer ticks for a time in microseconds, rounded up
+#define LCD_QUEUE_TICKS(us)		((unsigned short)(((uint32_t)(us) * (F_CPU / 1000000UL) + LCD_QUEUE_PRESCALER - 1) / LCD_QUEUE_PRESCALER))
+
+///Fewest ticks between interrupts, the compare value has to be ahead of the counter when the interrupt sets it
+#define LCD_QUEUE_MIN_TICKS		2
+
+#endif
+
+#if LCD_USE_PCF8574 == 1
+
+///Microseconds from one write's last E fall to the next write's first, the two bytes of a nibble on the bus
+#define LCD_PCF8574_NIBBLE_US	((unsigned short)(18000000UL / F_I2C))
+
+///Holds one I2C transaction open for every write until the matching LCD_END_BURST
+#define LCD_BEGIN_BURST()		LcdBeginBurst()
+
+///Closes the transaction when the outermost burst ends
+#define LCD_END_BURST()			LcdEndBurst()
+
+#else
+
+#define LCD_BEGIN_BURST()
+
+#define LCD_END_BURST()
+
+#endif
+
 
 
 ///The first positions in each row, in order from top to bottom
@@ -19,6 +65,409 @@ unsigned char m_uchrCurrentLine = 0;
 ///The column we're currently at on the LCD
 unsigned char m_uchrCurrentColumn = 0;
 
+///Set once the startup sequence is sent, the busy flag can't be read and writes aren't queued before then
+static bool m_bStartupDone = false;
+
+#if LCD_USE_SHADOW_BUFFER == 1
+
+///The LCD's address counter is not known
+#define LCD_ADDRESS_UNKNOWN		0xFF
+
+///The screen as printed, sent to the LCD by LcdFlush
+static unsigned char m_aauchrShadow[LCD_ROW_COUNT][LCD_COLUMN_COUNT];
+
+///The screen as last sent to the LCD
+static unsigned char m_aauchrSent[LCD_ROW_COUNT][LCD_COLUMN_COUNT];
+
+///The LCD's DD RAM address counter, followed through each command and data write
+static unsigned char m_uchrDisplayAddress = LCD_ADDRESS_UNKNOWN;
+
+#endif
+
+#if LCD_USE_QUEUE == 1
+
+///Bytes waiting to be sent by the timer interrupt
+static volatile unsigned char m_auchrQueueBytes[LCD_QUEUE_SIZE];
+
+///If each queued byte is data or a command
+static volatile bool m_abQueueIsData[LCD_QUEUE_SIZE];
+
+///Where the next byte is queued, only moved by LcdQueuePush
+static volatile unsigned char m_uchrQueueHead = 0;
+
+///The next byte to send, only moved by the interrupt
+static volatile unsigned char m_uchrQueueTail = 0;
+
+///Set while the timer runs, cleared by the interrupt once the queue is empty and the last write has finished
+static volatile bool m_bQueueRunning = false;
+
+///Ticks left of the current wait, waits longer than the 8 bit timer are split over several interrupts
+static unsigned short m_ushtQueueWaitTicks = 0;
+
+///Set when the high nibble of the byte at the tail is sent and the low nibble is next
+static bool m_bQueueLowNibble = false;
+
+#endif
+
+#if LCD_USE_GLYPH_CACHE == 1
+
+///CG RAM slots in the glyph cache
+#define LCD_GLYPH_SLOTS			(8 - LCD_GLYPH_FIRST_SLOT)
+
+///Glyph ID of an empty slot
+#define LCD_GLYPH_NONE			0xFF
+
+///The glyph ID in each slot of the cache
+static unsigned char m_auchrGlyphSlots[LCD_GLYPH_SLOTS];
+
+///Slots of the cache from most to least recently used
+static unsigned char m_auchrGlyphOrder[LCD_GLYPH_SLOTS];
+
+///Called with the ID of each glyph that loses its slot
+static void (*m_pfnGlyphEvicted)(unsigned char uchrGlyph) = 0;
+
+#endif
+
+#if LCD_USE_PCF8574 == 1
+
+///Set while an I2C transaction with the backpack is open
+static bool m_bPcfOpen = false;
+
+///Bursts begun and not yet ended
+static unsigned char m_uchrPcfBurstDepth = 0;
+
+///The backpack's pins as last sent
+static unsigned char m_uchrPcfPins = 0;
+
+///The backlight bit held in every byte sent
+static unsigned char m_uchrPcfBacklight = (1 << LCD_PCF8574_BACKLIGHT);
+
+#endif
+
+
+
+#if LCD_USE_PCF8574 != 1
+/**
+* \brief Waits for the LCD to finish a write, polls the busy flag when LCD_USE_BUSY_FLAG is 1 or else waits the worst case time
+* \param ushtWorstCaseTime The worst case execution time of the write in microseconds
+*/
+static void LcdWaitForCompletion(unsigned short ushtWorstCaseTime)
+{
+	#if LCD_USE_BUSY_FLAG == 1
+	if(m_bStartupDone)
+	{
+		LcdBusyFlagWait();
+		return;
+	}
+	#endif
+	
+	delayForMicroseconds(ushtWorstCaseTime);
+}
+#endif
+
+
+
+/**
+* \brief Gets the worst case execution time of a write
+* \param bIsData If the write is data
+* \param uchrByte The byte written
+* \return The time in microseconds
+*/
+static unsigned short LcdExecutionTime(bool bIsData, unsigned char uchrByte)
+{
+	//Clear display and return home take far longer than anything else
+	if(!bIsData && uchrByte < 0x04)
+	{
+		return LCD_CLEAR_HOME_TIME_US;
+	}
+	
+	return LCD_EXECUTION_TIME_US;
+}
+
+
+
+#if LCD_USE_PCF8574 == 1
+/**
+* \brief Opens a transaction with the backpack if one isn't open
+*/
+static void LcdPcfOpen()
+{
+	if(!m_bPcfOpen)
+	{
+		I2CStart((LCD_PCF8574_ADDRESS << 1) | 0);
+		m_bPcfOpen = true;
+	}
+}
+
+
+
+/**
+* \brief Closes the transaction with the backpack unless a burst is holding it open
+*/
+static void LcdPcfClose()
+{
+	if(m_bPcfOpen && m_uchrPcfBurstDepth == 0)
+	{
+		i2c_stop();
+		m_bPcfOpen = false;
+	}
+}
+
+
+
+/**
+* \brief Sends a nibble through the open transaction as E high then E low, RS gets a byte of its own first when it changes
+* \param bIsData If RS is set for data
+* \param uchrNibble The nibble, in the low 4 bits
+*/
+static void LcdPcfNibble(bool bIsData, unsigned char uchrNibble)
+{
+	unsigned char uchrPins = m_uchrPcfBacklight | (uchrNibble << LCD_PCF8574_D4); //RW stays low
+	
+	if(bIsData)
+	{
+		uchrPins |= (1 << LCD_PCF8574_RS);
+	}
+	
+	//RS has to settle before E rises
+	if((uchrPins ^ m_uchrPcfPins) & (1 << LCD_PCF8574_RS))
+	{
+		I2CByte(uchrPins);
+	}
+	
+	I2CByte(uchrPins | (1 << LCD_PCF8574_E));
+	I2CByte(uchrPins);
+	m_uchrPcfPins = uchrPins;
+}
+#else
+/**
+* \brief Pulses E with the data pins set, the whole byte in 8 bit mode or one nibble in 4 bit mode
+* \param bIsData If RS is set for data
+* \param uchrPins The value of the data pins, from the 4 bit helpers in 4 bit mode
+*/
+static void LcdStrobe(bool bIsData, unsigned char uchrPins)
+{
+	LCD_CONTROL_PORT &= ~(1 << LCD_RW_PIN);
+	
+	if(bIsData)
+	{
+		LCD_CONTROL_PORT |= (1 << LCD_RS_PIN);
+	}
+	else
+	{
+		LCD_CONTROL_PORT &= ~(1 << LCD_RS_PIN);
+	}
+	
+	LCD_CONTROL_PORT |= (1 << LCD_E_PIN);
+	
+	#if !defined(LCD_USE_4_BIT_MODE) || LCD_USE_4_BIT_MODE != 1
+	LCD_DATA_PORT &= ~(0xFF);
+	#else
+	LCD_DATA_PORT &= (~LCD_4_BIT_DATA_PIN_MASK);
+	#endif
+	
+	LCD_DATA_PORT |= uchrPins;
+	delayForMicroseconds(1);
+	LCD_CONTROL_PORT &= ~(1 << LCD_E_PIN);
+}
+#endif
+
+
+
+/**
+* \brief Sends a byte to the LCD and waits for it to be done
+* \param bIsData If the byte is data or a command
+* \param uchrByte The byte
+*/
+static void LcdSendNow(bool bIsData, unsigned char uchrByte)
+{
+	#if LCD_USE_PCF8574 == 1
+	unsigned short ushtTime = LcdExecutionTime(bIsData, uchrByte); //Execution time of the write
+	
+	LcdPcfOpen();
+	LcdPcfNibble(bIsData, uchrByte >> 4);
+	LcdPcfNibble(bIsData, uchrByte & 0x0F);
+	LcdPcfClose();
+	
+	//The bus covers the execution time of most writes before the next one is latched
+	if(ushtTime > LCD_PCF8574_NIBBLE_US)
+	{
+		delayForMicroseconds(ushtTime - LCD_PCF8574_NIBBLE_US);
+	}
+	#else
+	
+	#if !defined(LCD_USE_4_BIT_MODE) || LCD_USE_4_BIT_MODE != 1
+	LcdStrobe(bIsData, uchrByte);
+	#else
+	LcdStrobe(bIsData, __LCD_4_BIT_VAL_WRITER_HELPER_HIGH(uchrByte));
+	delayForMicroseconds(1);
+	LcdStrobe(bIsData, __LCD_4_BIT_VAL_WRITER_HELPER_LOW(uchrByte));
+	#endif
+	
+	LcdWaitForCompletion(LcdExecutionTime(bIsData, uchrByte));
+	#endif
+}
+
+
+
+#if LCD_USE_QUEUE == 1
+/**
+* \brief Sets the time to the next interrupt, up to what the 8 bit timer can count
+* \param ushtTicks The ticks left to wait
+* \return The ticks until the next interrupt
+*/
+static unsigned short LcdQueueSetPeriod(unsigned short ushtTicks)
+{
+	ushtTicks = min(max(ushtTicks, LCD_QUEUE_MIN_TICKS), 256);
+	OCR2A = ushtTicks - 1;
+	
+	return ushtTicks;
+}
+
+
+
+/**
+* \brief Puts a byte at the head of the queue and starts the timer if it is stopped, waits while the queue is full
+* \param bIsData If the byte is data or a command
+* \param uchrByte The byte
+*/
+static void LcdQueuePush(bool bIsData, unsigned char uchrByte)
+{
+	unsigned char uchrNextHead = m_uchrQueueHead + 1; //Where the head moves to
+	unsigned char uchrSREG = 0; //Interrupt state while the timer is checked
+	
+	if(uchrNextHead >= LCD_QUEUE_SIZE)
+	{
+		uchrNextHead = 0;
+	}
+	
+	//Full, the interrupt makes room
+	while(uchrNextHead == m_uchrQueueTail);
+	
+	m_auchrQueueBytes[m_uchrQueueHead] = uchrByte;
+	m_abQueueIsData[m_uchrQueueHead] = bIsData;
+	m_uchrQueueHead = uchrNextHead;
+	
+	//The interrupt stops the timer when it finds the queue empty, so check it with interrupts off
+	uchrSREG = SREG;
+	cli();
+	
+	if(!m_bQueueRunning)
+	{
+		m_bQueueRunning = true;
+		m_ushtQueueWaitTicks = 0;
+		m_bQueueLowNibble = false;
+		
+		TCCR2B = 0;
+		TCCR2A = (1 << WGM21);
+		TCNT2 = 0;
+		LcdQueueSetPeriod(LCD_QUEUE_MIN_TICKS);
+		TIFR2 = (1 << OCF2A);
+		TIMSK2 |= (1 << OCIE2A);
+		TCCR2B = LCD_QUEUE_CLOCK_SELECT;
+	}
+	
+	SREG = uchrSREG;
+}
+
+
+
+/**
+* \brief Timer 2 compare A interrupt. Sends the byte at the tail of the queue, a nibble at a time in 4 bit mode,
+* then waits out its execution time before the next one. Stops the timer once the queue is empty.
+*/
+ISR(TIMER2_COMPA_vect)
+{
+	unsigned char uchrByte = 0; //The byte at the tail
+	bool bIsData = false; //If the byte at the tail is data
+	
+	//Still waiting on the last write
+	if(m_ushtQueueWaitTicks > 0)
+	{
+		m_ushtQueueWaitTicks -= LcdQueueSetPeriod(m_ushtQueueWaitTicks);
+		return;
+	}
+	
+	if(m_uchrQueueTail == m_uchrQueueHead)
+	{
+		TCCR2B = 0;
+		TIMSK2 &= ~(1 << OCIE2A);
+		m_bQueueRunning = false;
+		return;
+	}
+	
+	uchrByte = m_auchrQueueBytes[m_uchrQueueTail];
+	bIsData = m_abQueueIsData[m_uchrQueueTail];
+	
+	#if !defined(LCD_USE_4_BIT_MODE) || LCD_USE_4_BIT_MODE != 1
+	LcdStrobe(bIsData, uchrByte);
+	#else
+	if(!m_bQueueLowNibble)
+	{
+		LcdStrobe(bIsData, __LCD_4_BIT_VAL_WRITER_HELPER_HIGH(uchrByte));
+		m_bQueueLowNibble = true;
+		LcdQueueSetPeriod(LCD_QUEUE_MIN_TICKS);
+		return;
+	}
+	
+	LcdStrobe(bIsData, __LCD_4_BIT_VAL_WRITER_HELPER_LOW(uchrByte));
+	m_bQueueLowNibble = false;
+	#endif
+	
+	m_uchrQueueTail = (m_uchrQueueTail + 1 >= LCD_QUEUE_SIZE) ? 0 : m_uchrQueueTail + 1;
+	
+	m_ushtQueueWaitTicks = LCD_QUEUE_TICKS(LcdExecutionTime(bIsData, uchrByte));
+	m_ushtQueueWaitTicks -= LcdQueueSetPeriod(m_ushtQueueWaitTicks);
+}
+
+
+
+/**
+* \brief Waits until everything queued is sent and the LCD has finished the last write. Global interrupts must be on.
+*/
+void LcdWaitForQueue()
+{
+	while(m_bQueueRunning);
+}
+#endif
+
+
+
+/**
+* \brief Queues a byte when LCD_USE_QUEUE is 1, or else sends it and waits for it to be done
+* \param bIsData If the byte is data or a command
+* \param uchrByte The byte
+*/
+static void LcdWrite(bool bIsData, unsigned char uchrByte)
+{
+	#if LCD_USE_QUEUE == 1
+	//The startup sequence keeps its own delays so is sent straight away
+	if(m_bStartupDone)
+	{
+		LcdQueuePush(bIsData, uchrByte);
+		return;
+	}
+	#endif
+	
+	LcdSendNow(bIsData, uchrByte);
+}
+
+
+
+#if LCD_USE_GLYPH_CACHE == 1
+/**
+* \brief Empties every slot of the glyph cache
+*/
+static void LcdGlyphReset()
+{
+	for(unsigned char i = 0; i < LCD_GLYPH_SLOTS; i++)
+	{
+		m_auchrGlyphSlots[i] = LCD_GLYPH_NONE;
+		m_auchrGlyphOrder[i] = i;
+	}
+}
+#endif
+
 
 /**
 * \brief Initializes the LCD from CONST values
@@ -31,6 +480,35 @@ void LcdConstInit(const unsigned char startupSequence[], const unsigned char lin
 	unsigned char index = 0; //Index for looping through the passed arrays.
 	unsigned char currentByte = 0; //The current byte we're on in the parameters.
 	
+	#if LCD_USE_QUEUE == 1
+	//The interrupt drives the pins until the queue is empty
+	LcdWaitForQueue();
+	#endif
+	
+	m_bStartupDone = false;
+	
+	#if LCD_USE_GLYPH_CACHE == 1
+	//What is in CG RAM isn't known until glyphs are uploaded
+	LcdGlyphReset();
+	#endif
+	
+	#if LCD_USE_SHADOW_BUFFER == 1
+	//Nothing on the glass is known until a clear display command in the startup sequence
+	memset(m_aauchrShadow, ' ', sizeof(m_aauchrShadow));
+	memset(m_aauchrSent, 0x00, sizeof(m_aauchrSent));
+	m_uchrDisplayAddress = LCD_ADDRESS_UNKNOWN;
+	#endif
+	
+	#if LCD_USE_PCF8574 == 1
+	
+	//E, RS and RW low with the backlight as set
+	m_uchrPcfPins = m_uchrPcfBacklight;
+	LcdPcfOpen();
+	I2CByte(m_uchrPcfPins);
+	LcdPcfClose();
+	
+	#else
+	
 	LCD_CONTROL_PORT &= ~(1 << LCD_E_PIN | 1 << LCD_RS_PIN | 1 << LCD_RW_PIN);
 	
 	#if !defined(LCD_USE_4_BIT_MODE) || LCD_USE_4_BIT_MODE != 1
@@ -45,6 +523,8 @@ void LcdConstInit(const unsigned char startupSequence[], const unsigned char lin
 
 	#endif
 	
+	#endif
+	
 
 	//Loop through the initialization values and send as commands
 	for(index = 0; startupSequence[index] != '\0'; index++)
@@ -62,6 +542,7 @@ void LcdConstInit(const unsigned char startupSequence[], const unsigned char lin
 	}
 
 	delayForMicroseconds(10);
+	m_bStartupDone = true;
 }
 
 
@@ -73,14 +554,16 @@ void LcdConstInit(const unsigned char startupSequence[], const unsigned char lin
 */
 void LcdStoreCustomConstCharacter(unsigned char uchrAddress, const unsigned char auchrCharacter[8])
 {
+	LCD_BEGIN_BURST();
+	
 	LcdSendCommand(LCD_CG_RAM_CMD + uchrAddress);
 
 	for(unsigned char i = 0; i < 8; i++) {
 
 		LcdSendData(auchrCharacter[i]);
-		delayForMicroseconds(10);
 	}
 	
+	LCD_END_BURST();
 }
 
 
@@ -97,6 +580,35 @@ void LcdInit(unsigned char startupSequence[], unsigned char lineStartPositions[]
 	unsigned char index = 0; //Index for looping through the passed arrays.
     unsigned char currentByte = 0; //The current byte we're on in the parameters.
 	
+	#if LCD_USE_QUEUE == 1
+	//The interrupt drives the pins until the queue is empty
+	LcdWaitForQueue();
+	#endif
+	
+	m_bStartupDone = false;
+	
+	#if LCD_USE_GLYPH_CACHE == 1
+	//What is in CG RAM isn't known until glyphs are uploaded
+	LcdGlyphReset();
+	#endif
+	
+	#if LCD_USE_SHADOW_BUFFER == 1
+	//Nothing on the glass is known until a clear display command in the startup sequence
+	memset(m_aauchrShadow, ' ', sizeof(m_aauchrShadow));
+	memset(m_aauchrSent, 0x00, sizeof(m_aauchrSent));
+	m_uchrDisplayAddress = LCD_ADDRESS_UNKNOWN;
+	#endif
+	
+	#if LCD_USE_PCF8574 == 1
+	
+	//E, RS and RW low with the backlight as set
+	m_uchrPcfPins = m_uchrPcfBacklight;
+	LcdPcfOpen();
+	I2CByte(m_uchrPcfPins);
+	LcdPcfClose();
+	
+	#else
+	
 	LCD_CONTROL_PORT &= ~(1 << LCD_E_PIN | 1 << LCD_RS_PIN | 1 << LCD_RW_PIN);
 	
 	#if !defined(LCD_USE_4_BIT_MODE) || LCD_USE_4_BIT_MODE != 1
@@ -111,6 +623,8 @@ void LcdInit(unsigned char startupSequence[], unsigned char lineStartPositions[]
 
 	#endif
 	
+	#endif
+	
 
 	//Loop through the initialization values and send as commands
 	for(index = 0; startupSequence[index] != '\0'; index++) 
@@ -128,6 +642,7 @@ void LcdInit(unsigned char startupSequence[], unsigned char lineStartPositions[]
 	 }
 
 	delayForMicroseconds(10);
+	m_bStartupDone = true;
 }
 
 
@@ -158,6 +673,50 @@ unsigned char LcdGetCurrentColumn()
 
 
 
+/**
+* \brief Writes a character at the current position, into the shadow buffer when LCD_USE_SHADOW_BUFFER is 1
+* \param uchrChar The character to write
+*/
+static void LcdWriteCharacter(char uchrChar)
+{
+	#if LCD_USE_SHADOW_BUFFER == 1
+	m_aauchrShadow[m_uchrCurrentLine][m_uchrCurrentColumn] = uchrChar;
+	#else
+	LcdSendData(uchrChar);
+	#endif
+}
+
+
+
+/**
+* \brief Clears the screen, only the shadow buffer when LCD_USE_SHADOW_BUFFER is 1
+*/
+static void LcdClearDisplay()
+{
+	#if LCD_USE_SHADOW_BUFFER == 1
+	memset(m_aauchrShadow, ' ', sizeof(m_aauchrShadow));
+	#else
+	LcdSendCommand(LCD_CLEAR_SCREEN);
+	#endif
+}
+
+
+
+/**
+* \brief Sends a command that only moves the cursor, skipped when LCD_USE_SHADOW_BUFFER is 1 as LcdFlush puts the cursor back
+* \param cmd The command
+*/
+static void LcdSendCursorCommand(unsigned char cmd)
+{
+	#if LCD_USE_SHADOW_BUFFER != 1
+	LcdSendCommand(cmd);
+	#else
+	(void)cmd;
+	#endif
+}
+
+
+
 /**
  * \brief Sends a command to the LCD
  * 
@@ -166,31 +725,28 @@ unsigned char LcdGetCurrentColumn()
  */
 void LcdSendCommand(unsigned char cmd) 
 {
-	LCD_CONTROL_PORT &= ~(1 << LCD_RS_PIN | 1 << LCD_RW_PIN);
-	LCD_CONTROL_PORT |= (1 << LCD_E_PIN);
-	
-
-	#if !defined(LCD_USE_4_BIT_MODE) || LCD_USE_4_BIT_MODE != 1
-	LCD_DATA_PORT &= ~(0xFF);
-	LCD_DATA_PORT |= cmd;
-	LCD_CONTROL_PORT &= ~(1 << LCD_E_PIN);
-	delayForMilliseconds(1);
-	#else
-
-	LCD_DATA_PORT &= (~LCD_4_BIT_DATA_PIN_MASK);
-	LCD_DATA_PORT |= (__LCD_4_BIT_VAL_WRITER_HELPER_HIGH(cmd));
-	LCD_CONTROL_PORT &= ~(1 << LCD_E_PIN);
-	delayForMilliseconds(1);
-	LCD_CONTROL_PORT |= (1 << LCD_E_PIN);
+	LcdWrite(false, cmd);
 	
-	LCD_DATA_PORT &= (~LCD_4_BIT_DATA_PIN_MASK);
-	LCD_DATA_PORT |= (__LCD_4_BIT_VAL_WRITER_HELPER_LOW(cmd));
-	LCD_CONTROL_PORT &= ~(1 << LCD_E_PIN);
-	delayForMilliseconds(1);
-
+	#if LCD_USE_SHADOW_BUFFER == 1
+	if(cmd & LCD_DD_RAM_CMD)
+	{
+		m_uchrDisplayAddress = cmd & ~LCD_DD_RAM_CMD;
+	}
+	else if(cmd == LCD_CLEAR_SCREEN)
+	{
+		memset(m_aauchrSent, ' ', sizeof(m_aauchrSent));
+		m_uchrDisplayAddress = 0;
+	}
+	else if(cmd == LCD_RETURN_HOME || cmd == (LCD_RETURN_HOME | 0x01))
+	{
+		m_uchrDisplayAddress = 0;
+	}
+	else if(cmd >= LCD_CURSOR_SHIFT_L)
+	{
+		//Shifts and CG RAM addresses move the address counter somewhere else
+		m_uchrDisplayAddress = LCD_ADDRESS_UNKNOWN;
+	}
 	#endif
-
-	
 }
 
 
@@ -201,31 +757,13 @@ void LcdSendCommand(unsigned char cmd)
 */
 void LcdSendData(unsigned char data) 
 {
-	LCD_CONTROL_PORT &= ~(1 << LCD_RW_PIN);
-	LCD_CONTROL_PORT |= (1 << LCD_RS_PIN);
-	LCD_CONTROL_PORT |= (1 << LCD_E_PIN);
-	
-
-	#if !defined(LCD_USE_4_BIT_MODE) || LCD_USE_4_BIT_MODE != 1
+	LcdWrite(true, data);
 	
-	LCD_DATA_PORT &= ~(0xFF);
-	LCD_DATA_PORT |= data;
-	LCD_CONTROL_PORT &= ~(1 << LCD_E_PIN);
-	delayForMilliseconds(1);
-
-	#else
-
-	LCD_DATA_PORT &= (~LCD_4_BIT_DATA_PIN_MASK);
-	LCD_DATA_PORT |= (__LCD_4_BIT_VAL_WRITER_HELPER_HIGH(data));
-	LCD_CONTROL_PORT &= ~(1 << LCD_E_PIN);
-	delayForMilliseconds(1);
-	LCD_CONTROL_PORT |= (1 << LCD_E_PIN);
-	
-	LCD_DATA_PORT &= (~LCD_4_BIT_DATA_PIN_MASK);
-	LCD_DATA_PORT |= (__LCD_4_BIT_VAL_WRITER_HELPER_LOW(data));
-	LCD_CONTROL_PORT &= ~(1 << LCD_E_PIN);
-	delayForMilliseconds(1);
-
+	#if LCD_USE_SHADOW_BUFFER == 1
+	if(m_uchrDisplayAddress != LCD_ADDRESS_UNKNOWN)
+	{
+		m_uchrDisplayAddress++;
+	}
 	#endif
 }
 
@@ -237,48 +775,84 @@ void LcdSendData(unsigned char data)
 */
 void LcdStoreCGData(unsigned char cgAddress, unsigned char data[], uint8_t dataLength)
 {
+	LCD_BEGIN_BURST();
+	
 	LCD_set_cg_ram((cgAddress));
 
 	for(unsigned char i=0; i < dataLength; i++) 
 	{
 		LcdSendData(data[i]);
-		delayForMicroseconds(37);
 	}
 	
 	
+	LCD_END_BURST();
 }
 
 
 
 /**
-* \brief Waits for the LCD's busy flag to trigger
+* \brief Waits for the LCD's busy flag to clear, gives up after LCD_BUSY_FLAG_TIMEOUT_US so an LCD without RW wired can't hang the program
 *
 */
 void LcdBusyFlagWait() 
 {
+	#if LCD_USE_PCF8574 == 1
+	
+	//The backpack is only written to, wait as long as the slowest command takes
+	delayForMicroseconds(LCD_CLEAR_HOME_TIME_US);
+	
+	#else
+	
+	unsigned short ushtPolls = 0; //Polls so far, each takes at least a microsecond
+	bool bBusy = false; //The busy flag as last read
+	
+	#if LCD_USE_QUEUE == 1
+	//The interrupt drives the pins until the queue is empty
+	LcdWaitForQueue();
+	#endif
+	
 	//Set RW pin for READ mode
 	LCD_CONTROL_PORT &= ~(1 << LCD_RS_PIN);
 	LCD_CONTROL_PORT |= ( 1 << LCD_RW_PIN);
-
-	delayForMilliseconds(20);
 	
-	//Set the busy flag pin to input
+	//Set the busy flag pin to input, the rest of the data pins too as the LCD drives all of them while reading
 	LCD_DATA_PORT |= (1 << LCD_BUSY_FLAG_POSITION);
 	
-	setBitInput(LCD_DATA_PORT_DIR, LCD_BUSY_FLAG_POSITION);
+	#if !defined(LCD_USE_4_BIT_MODE) || LCD_USE_4_BIT_MODE != 1
+	LCD_DATA_PORT_DIR = (FULL_INPUT);
+	#else
+	writeMaskInput(LCD_DATA_PORT_DIR, LCD_4_BIT_DATA_PIN_MASK);
+	#endif
 	
-	//Toggle the E pin while the busy flag is high
+	//Toggle the E pin while the busy flag is high, the flag is only driven while E is high
 	do
 	{
 		LCD_CONTROL_PORT |= (1 << LCD_E_PIN);
 		delayForMicroseconds(1);
+		bBusy = readBit(LCD_DATA_PORT_READ,LCD_BUSY_FLAG_POSITION);
 		LCD_CONTROL_PORT &= ~(1 << LCD_E_PIN);
-	} while (readBit(LCD_DATA_PORT_READ,LCD_BUSY_FLAG_POSITION));
+		
+		#if defined(LCD_USE_4_BIT_MODE) && LCD_USE_4_BIT_MODE == 1
+		//Clock out the low nibble of the address counter so the next read starts on the high nibble again
+		delayForMicroseconds(1);
+		LCD_CONTROL_PORT |= (1 << LCD_E_PIN);
+		delayForMicroseconds(1);
+		LCD_CONTROL_PORT &= ~(1 << LCD_E_PIN);
+		#endif
+		
+	} while (bBusy && ++ushtPolls < LCD_BUSY_FLAG_TIMEOUT_US);
 	
 	
 	//Reset
 	LCD_CONTROL_PORT &= ~(1 << LCD_RS_PIN | 1 << LCD_RW_PIN | 1 << LCD_E_PIN);
-	setBitOutput(LCD_DATA_PORT_DIR, LCD_BUSY_FLAG_POSITION);
+	
+	#if !defined(LCD_USE_4_BIT_MODE) || LCD_USE_4_BIT_MODE != 1
+	LCD_DATA_PORT_DIR = (FULL_OUTPUT);
+	#else
+	writeMaskOutput(LCD_DATA_PORT_DIR, LCD_4_BIT_DATA_PIN_MASK);
+	#endif
+	
+	#endif
 }
 
 
@@ -307,6 +881,8 @@ void LcdDisplayOn(bool cursorOn, bool cursorBlink)
 */
 void LcdClearLine(unsigned char uchrLine) 
 {
+	LCD_BEGIN_BURST();
+	
 	if(uchrLine < LCD_ROW_COUNT) {
 		unsigned char savedColumn = m_uchrCurrentColumn;
 		unsigned char savedRow = m_uchrCurrentLine;
@@ -316,6 +892,8 @@ void LcdClearLine(unsigned char uchrLine)
 		}
 		LcdGoToPosition(savedRow, savedColumn);
 	}
+	
+	LCD_END_BURST();
 }
 
 
@@ -327,6 +905,8 @@ void LcdClearLine(unsigned char uchrLine)
 */
 void LcdClearLineFromColumn(unsigned char uchrLine, unsigned char uchrColumn) 
 {
+	LCD_BEGIN_BURST();
+	
 	if(uchrLine < LCD_ROW_COUNT && uchrColumn < LCD_COLUMN_COUNT - 1) {
 		unsigned char savedColumn = m_uchrCurrentColumn;
 		unsigned char savedRow = m_uchrCurrentLine;
@@ -336,6 +916,8 @@ void LcdClearLineFromColumn(unsigned char uchrLine, unsigned char uchrColumn)
 		}
 		LcdGoToPosition(savedRow, savedColumn);
 	}
+	
+	LCD_END_BURST();
 }
 
 
@@ -350,6 +932,8 @@ void LcdClearLineAtColumns(unsigned char uchrLine, unsigned char uchrStartColumn
 {
     
     
+	LCD_BEGIN_BURST();
+	
 	if(uchrLine < LCD_ROW_COUNT && (uchrStartColumn < LCD_COLUMN_COUNT - 1 || uchrEndColumn < LCD_COLUMN_COUNT - 1)) {
 		unsigned char savedColumn = m_uchrCurrentColumn;
 		unsigned char savedRow = m_uchrCurrentLine;
@@ -359,6 +943,8 @@ void LcdClearLineAtColumns(unsigned char uchrLine, unsigned char uchrStartColumn
 		}
 		LcdGoToPosition(savedRow, savedColumn);
 	}
+	
+	LCD_END_BURST();
 }
 
 
@@ -390,7 +976,6 @@ void LcdStoreDotRow(unsigned char uchrAddress, unsigned char uchrNewDot)
 {
 	LCD_set_cg_ram(uchrAddress);
 	LcdSendData(uchrNewDot);
-	LcdBusyFlagWait();
 }
 
 
@@ -402,17 +987,177 @@ void LcdStoreDotRow(unsigned char uchrAddress, unsigned char uchrNewDot)
 */
 void LcdStoreCustomCharacter(unsigned char uchrAddress, unsigned char auchrCharacter[8]) 
 {
+	LCD_BEGIN_BURST();
+	
 	LcdSendCommand(LCD_CG_RAM_CMD + uchrAddress);
 	
 	for(unsigned char i = 0; i < 8; i++) {
 
 		LcdSendData(auchrCharacter[i]);
-		delayForMicroseconds(10);
 	}
+	
+	LCD_END_BURST();
+}
+
+
+
+#if LCD_USE_GLYPH_CACHE == 1
+#if LCD_USE_SHADOW_BUFFER == 1
+/**
+* \brief Checks if a CG RAM character is on the screen in the shadow buffer
+* \param uchrCode The character code, 0 to 7
+* \return true if any cell holds the code or its copy at code + 8
+*/
+static bool LcdShadowShows(unsigned char uchrCode)
+{
+	for(unsigned char uchrLine = 0; uchrLine < LCD_ROW_COUNT; uchrLine++)
+	{
+		for(unsigned char uchrColumn = 0; uchrColumn < LCD_COLUMN_COUNT; uchrColumn++)
+		{
+			if((m_aauchrShadow[uchrLine][uchrColumn] & ~0x08) == uchrCode)
+			{
+				return true;
+			}
+		}
+	}
+	
+	return false;
+}
+#endif
+
+
+
+/**
+* \brief Gets the character code of a glyph, uploading its pattern into the least recently used slot if it isn't in one
+* \param uchrGlyph The glyph ID, 0 to 254
+* \param auchrPattern The 8 rows of the glyph, only read when it is uploaded
+* \return The character code to print, LCD_GLYPH_FIRST_SLOT to 7
+*/
+unsigned char LcdGlyphUse(unsigned char uchrGlyph, const unsigned char auchrPattern[8])
+{
+	unsigned char uchrOrder = 0; //Position of the slot in m_auchrGlyphOrder
+	unsigned char uchrSlot = 0; //The slot used
+	unsigned char uchrEvicted = LCD_GLYPH_NONE; //The glyph that was in the slot
+	
+	while(uchrOrder < LCD_GLYPH_SLOTS && m_auchrGlyphSlots[m_auchrGlyphOrder[uchrOrder]] != uchrGlyph)
+	{
+		uchrOrder++;
+	}
+	
+	if(uchrOrder == LCD_GLYPH_SLOTS)
+	{
+		uchrOrder = LCD_GLYPH_SLOTS - 1;
+		
+		#if LCD_USE_SHADOW_BUFFER == 1
+		//Pass over glyphs still on the screen while there is another choice, empty slots are always last
+		for(unsigned char i = LCD_GLYPH_SLOTS; i > 0; i--)
+		{
+			uchrSlot = m_auchrGlyphOrder[i-1];
+			
+			if(m_auchrGlyphSlots[uchrSlot] == LCD_GLYPH_NONE || !LcdShadowShows(LCD_GLYPH_FIRST_SLOT + uchrSlot))
+			{
+				uchrOrder = i-1;
+				break;
+			}
+		}
+		#endif
+		
+		uchrSlot = m_auchrGlyphOrder[uchrOrder];
+		uchrEvicted = m_auchrGlyphSlots[uchrSlot];
+		m_auchrGlyphSlots[uchrSlot] = uchrGlyph;
+		
+		//Leaves the address counter in CG RAM, printing goes back to the current position first
+		LcdStoreCustomConstCharacter((LCD_GLYPH_FIRST_SLOT + uchrSlot) * 8, auchrPattern);
+	}
+	
+	//Move the slot to the front as the most recently used
+	uchrSlot = m_auchrGlyphOrder[uchrOrder];
+	
+	for(; uchrOrder > 0; uchrOrder--)
+	{
+		m_auchrGlyphOrder[uchrOrder] = m_auchrGlyphOrder[uchrOrder-1];
+	}
+	
+	m_auchrGlyphOrder[0] = uchrSlot;
+	
+	if(uchrEvicted != LCD_GLYPH_NONE && m_pfnGlyphEvicted != 0)
+	{
+		m_pfnGlyphEvicted(uchrEvicted);
+	}
+	
+	return LCD_GLYPH_FIRST_SLOT + uchrSlot;
+}
+
+
+
+/**
+* \brief Prints a glyph at the current position, uploading it first if it isn't in a slot
+* \param uchrGlyph The glyph ID, 0 to 254
+* \param auchrPattern The 8 rows of the glyph
+*/
+void LcdPrintGlyph(unsigned char uchrGlyph, const unsigned char auchrPattern[8])
+{
+	LcdPrintChar(LcdGlyphUse(uchrGlyph, auchrPattern));
+}
+
+
+
+/**
+* \brief Sets the function called with the ID of each glyph that loses its slot, cells still showing it show the new glyph
+* \param callback The function, 0 for none
+*/
+void LcdGlyphSetEvictionCallback(void (*callback)(unsigned char uchrGlyph))
+{
+	m_pfnGlyphEvicted = callback;
+}
+#endif
+
+
+
+#if LCD_USE_PCF8574 == 1
+/**
+* \brief Holds the I2C transaction with the backpack open for every write until the matching LcdEndBurst, bursts can be nested
+*/
+void LcdBeginBurst()
+{
+	m_uchrPcfBurstDepth++;
+}
+
+
+
+/**
+* \brief Ends a burst, the transaction is closed when the outermost burst ends
+*/
+void LcdEndBurst()
+{
+	if(m_uchrPcfBurstDepth > 0)
+	{
+		m_uchrPcfBurstDepth--;
+	}
+	
+	LcdPcfClose();
 }
 
 
 
+/**
+* \brief Turns the backpack's backlight on or off
+* \param bOn If the backlight is on
+*/
+void LcdSetBacklight(bool bOn)
+{
+	m_uchrPcfBacklight = bOn ? (1 << LCD_PCF8574_BACKLIGHT) : 0;
+	m_uchrPcfPins = (m_uchrPcfPins & ~(1 << LCD_PCF8574_BACKLIGHT)) | m_uchrPcfBacklight;
+	
+	LcdPcfOpen();
+	I2CByte(m_uchrPcfPins);
+	LcdPcfClose();
+}
+#endif
+
+
+
+#if LCD_USE_PCF8574 != 1
 /**
 * \brief Reads and returns the address counter from the LCD
 *
@@ -422,6 +1167,11 @@ unsigned char LcdGetAddressCounter()
 	//Variables
 	unsigned char address = 0; //The address returned
 	
+	#if LCD_USE_QUEUE == 1
+	//The interrupt drives the pins until the queue is empty
+	LcdWaitForQueue();
+	#endif
+	
 	//Set RW pin for READ mode
 	LCD_CONTROL_PORT &= ~(1 << LCD_RS_PIN);
 	LCD_CONTROL_PORT |= ( 1 << LCD_RW_PIN);
@@ -462,6 +1212,7 @@ unsigned char LcdGetAddressCounter()
 
 	return address;
 }
+#endif
 
 
 
@@ -491,9 +1242,59 @@ void LcdGoToPosition(unsigned char uchrLine, unsigned char uchrColumn)
 	}
 	
 	
+	#if LCD_USE_SHADOW_BUFFER != 1
 	unsigned char uchrNewAddress = ((m_auchrLineStartValues[m_uchrCurrentLine]) + m_uchrCurrentColumn);
 	LCD_set_dd_ram(uchrNewAddress);
+	#endif
+}
+
+
+
+#if LCD_USE_SHADOW_BUFFER == 1
+/**
+* \brief Sends the characters that changed since the last flush, then puts the cursor at the current position
+* 
+* Each run of changed characters costs one DD RAM address command, none if the address counter is already there.
+* Nothing is sent when nothing changed and the cursor did not move.
+*/
+void LcdFlush()
+{
+	unsigned char uchrAddress = 0; //The DD RAM address of the cell
+	
+	LCD_BEGIN_BURST();
+	
+	for(unsigned char uchrLine = 0; uchrLine < LCD_ROW_COUNT; uchrLine++)
+	{
+		for(unsigned char uchrColumn = 0; uchrColumn < LCD_COLUMN_COUNT; uchrColumn++)
+		{
+			if(m_aauchrShadow[uchrLine][uchrColumn] == m_aauchrSent[uchrLine][uchrColumn])
+			{
+				continue;
+			}
+			
+			uchrAddress = m_auchrLineStartValues[uchrLine] + uchrColumn;
+			
+			//The address counter follows on from the last write within a run
+			if(m_uchrDisplayAddress != uchrAddress)
+			{
+				LCD_set_dd_ram(uchrAddress);
+			}
+			
+			LcdSendData(m_aauchrShadow[uchrLine][uchrColumn]);
+			m_aauchrSent[uchrLine][uchrColumn] = m_aauchrShadow[uchrLine][uchrColumn];
+		}
+	}
+	
+	uchrAddress = m_auchrLineStartValues[m_uchrCurrentLine] + min(m_uchrCurrentColumn, LCD_COLUMN_COUNT - 1);
+	
+	if(m_uchrDisplayAddress != uchrAddress)
+	{
+		LCD_set_dd_ram(uchrAddress);
+	}
+	
+	LCD_END_BURST();
 }
+#endif
 
 
 
@@ -508,7 +1309,7 @@ void LcdPerformCommand(unsigned char cmd)
     case LCD_RETURN_HOME://Return home
         m_uchrCurrentColumn = 0;
         m_uchrCurrentLine = 0;
-        LcdSendCommand(LCD_RETURN_HOME);
+        LcdSendCursorCommand(LCD_RETURN_HOME);
         break;
 
     case LCD_CR://Carriage return
@@ -520,13 +1321,13 @@ void LcdPerformCommand(unsigned char cmd)
 	case LCD_CLEAR_SCREEN:
         m_uchrCurrentColumn = 0;
         m_uchrCurrentLine = 0;
-        LcdSendCommand(LCD_CLEAR_SCREEN);
+        LcdClearDisplay();
         break;
 		
 	case LCD_FF:
         m_uchrCurrentColumn = 0;
         m_uchrCurrentLine = 0;
-        LcdSendCommand(LCD_CLEAR_SCREEN);
+        LcdClearDisplay();
         break;
 		
     case LCD_LF: //Line feed \n
@@ -536,7 +1337,7 @@ void LcdPerformCommand(unsigned char cmd)
 		}
 		else {
 			m_uchrCurrentLine = 0;
-			LcdSendCommand (LCD_CLEAR_SCREEN);
+			LcdClearDisplay();
 		}
 		
 		LcdGoToPosition(m_uchrCurrentLine, m_uchrCurrentColumn);
@@ -575,10 +1376,10 @@ void LcdPerformCommand(unsigned char cmd)
 		
 		if(m_uchrCurrentColumn > 0) {
 			m_uchrCurrentColumn -= 1;
-			LcdSendCommand(LCD_CURSOR_SHIFT_L);
+			LcdSendCursorCommand(LCD_CURSOR_SHIFT_L);
 			LcdPrintChar(' ');
 			m_uchrCurrentColumn -= 1;
-			LcdSendCommand(LCD_CURSOR_SHIFT_L);
+			LcdSendCursorCommand(LCD_CURSOR_SHIFT_L);
 		}
 		else if(m_uchrCurrentLine > 0) {
 			m_uchrCurrentColumn = LCD_COLUMN_COUNT - 1;
@@ -587,7 +1388,7 @@ void LcdPerformCommand(unsigned char cmd)
 			LcdPrintChar(' ');
 			m_uchrCurrentColumn = LCD_COLUMN_COUNT - 1;
 			m_uchrCurrentLine -= 1;
-			LcdSendCommand (LCD_CURSOR_SHIFT_L);
+			LcdSendCursorCommand(LCD_CURSOR_SHIFT_L);
 		}
 		
         break;
@@ -595,14 +1396,14 @@ void LcdPerformCommand(unsigned char cmd)
     case LCD_RT: //Right
 		if(m_uchrCurrentColumn < LCD_COLUMN_COUNT - 1) {
 			m_uchrCurrentColumn++;
-			LcdSendCommand (LCD_CURSOR_SHIFT_R);
+			LcdSendCursorCommand(LCD_CURSOR_SHIFT_R);
 		}
         break;
 
     case LCD_LFT: //Left
         if(m_uchrCurrentColumn > 0) {
 	        m_uchrCurrentColumn--;
-			LcdSendCommand (LCD_CURSOR_SHIFT_L);
+			LcdSendCursorCommand(LCD_CURSOR_SHIFT_L);
         }
         break;
 		
@@ -704,7 +1505,7 @@ void LcdPrintChar(char uchrChar)
 	
 	if(m_uchrCurrentColumn > LCD_COLUMN_COUNT-1) {
 		if(m_uchrCurrentLine > LCD_ROW_COUNT-1) {
-			LcdSendCommand(LCD_CLEAR_SCREEN);
+			LcdClearDisplay();
 			m_uchrCurrentColumn = 0;
 			m_uchrCurrentLine = 0;
 		}
@@ -716,7 +1517,7 @@ void LcdPrintChar(char uchrChar)
 	
 	LcdGoToPosition(m_uchrCurrentLine, m_uchrCurrentColumn);
 	
-	LcdSendData(uchrChar);
+	LcdWriteCharacter(uchrChar);
     
     m_uchrCurrentColumn+=1;
 }
@@ -733,7 +1534,7 @@ void LcdPrintCharDelay(char uchrChar, unsigned short ushtDelayTime)
 	
 	if(m_uchrCurrentColumn > LCD_COLUMN_COUNT-1) {
 		if(m_uchrCurrentLine > LCD_ROW_COUNT-1) {
-			LcdSendCommand(LCD_CLEAR_SCREEN);
+			LcdClearDisplay();
 			m_uchrCurrentColumn = 0;
 			m_uchrCurrentLine = 0;
 		}
@@ -747,7 +1548,7 @@ void LcdPrintCharDelay(char uchrChar, unsigned short ushtDelayTime)
     
 	
 	
-	LcdSendData(uchrChar);
+	LcdWriteCharacter(uchrChar);
 	delayForMicroseconds(ushtDelayTime);
     
     m_uchrCurrentColumn+=1;
@@ -766,7 +1567,7 @@ void LcdPrintCharAtPosition(char uchrChar, unsigned char uchrRow, unsigned char
 {
 	if(uchrColumn > LCD_COLUMN_COUNT-1) {
 		if(uchrRow > LCD_ROW_COUNT-1) {
-			LcdSendCommand(LCD_CLEAR_SCREEN);
+			LcdClearDisplay();
 			m_uchrCurrentColumn = 0;
 			m_uchrCurrentLine = 0;
 		}
@@ -779,7 +1580,7 @@ void LcdPrintCharAtPosition(char uchrChar, unsigned char uchrRow, unsigned char
     
     LcdGoToPosition(uchrRow, uchrColumn);
 	
-	LcdSendData(uchrChar);
+	LcdWriteCharacter(uchrChar);
     
     m_uchrCurrentColumn+=1;
 }
@@ -797,7 +1598,7 @@ void LcdPrintCharDelayAtPosition(char uchrChar, unsigned char uchrRow, unsigned
 {
 	if(uchrColumn > LCD_COLUMN_COUNT-1) {
 		if(uchrRow > LCD_ROW_COUNT-1) {
-			LcdSendCommand(LCD_CLEAR_SCREEN);
+			LcdClearDisplay();
 			m_uchrCurrentColumn = 0;
 			m_uchrCurrentLine = 0;
 		}
@@ -808,7 +1609,7 @@ void LcdPrintCharDelayAtPosition(char uchrChar, unsigned char uchrRow, unsigned
 	}
 	LcdGoToPosition(uchrRow, uchrColumn);
 	
-	LcdSendData(uchrChar);
+	LcdWriteCharacter(uchrChar);
     
     m_uchrCurrentColumn+=1;
     
@@ -825,6 +1626,8 @@ void LcdPrintString(char* strToSend)
 {
 	unsigned char currentByte = 0;
 
+	LCD_BEGIN_BURST();
+	
 	while(*strToSend)
 	{	
 		currentByte = (*strToSend++);
@@ -832,6 +1635,8 @@ void LcdPrintString(char* strToSend)
         
 		LcdPrintChar(currentByte);
 	}
+	
+	LCD_END_BURST();
 }
 
 
@@ -864,6 +1669,8 @@ void LcdPrintStringAtPosition(char* strToSend, unsigned char uchrRow, unsigned c
 {
 	unsigned char currentByte = 0;
 
+	LCD_BEGIN_BURST();
+	
 	LcdGoToPosition(uchrRow, uchrColumn);
 
 	while(*strToSend)
@@ -871,6 +1678,8 @@ void LcdPrintStringAtPosition(char* strToSend, unsigned char uchrRow, unsigned c
 		currentByte = (*strToSend++);
 		LcdPrintChar(currentByte);
 	}
+	
+	LCD_END_BURST();
 }
 
 
@@ -904,11 +1713,15 @@ void LcdPrintStringDelayAtPosition(char* strToSend, unsigned char uchrRow, unsig
 void LcdPrint(char* strToSend) 
 {
 	unsigned char currentByte = 0;
+	LCD_BEGIN_BURST();
+	
 	while(*strToSend)
 	{
 		currentByte = (*strToSend++);
 		LcdSendByte(currentByte);
 	}
+	
+	LCD_END_BURST();
 }
 
 
@@ -941,6 +1754,8 @@ void LcdPrintAtPosition(char* strToSend, unsigned char uchrRow, unsigned char uc
 {
 	unsigned char currentByte = 0;
 	
+	LCD_BEGIN_BURST();
+	
 	LcdGoToPosition(uchrRow, uchrColumn);
 
 	while(*strToSend)
@@ -948,6 +1763,8 @@ void LcdPrintAtPosition(char* strToSend, unsigned char uchrRow, unsigned char uc
 		currentByte = (*strToSend++);
 		LcdSendByte(currentByte);
 	}
+	
+	LCD_END_BURST();
 }
 
 
@@ -1003,10 +1820,14 @@ void LcdPrintNumericalByte(uint8_t numVal)
 	thirdValue += 0x30;
 	strToPrint[2] = (char)thirdValue;
 	
+	LCD_BEGIN_BURST();
+	
 	for(uint8_t i = 0; i < 3; i++)
 	{
 		LcdPrintChar(strToPrint[i]);	
 	}
+	
+	LCD_END_BURST();
 }
 
 
@@ -1081,12 +1902,16 @@ void LcdPrintNumericalByteAtPosition(uint8_t numVal, unsigned char uchrRow, unsi
 	thirdValue += 0x30;
 	strToPrint[2] = (char)thirdValue;
 	
+	LCD_BEGIN_BURST();
+	
 	LcdGoToPosition(uchrRow, uchrColumn);
 	
 	for(uint8_t i = 0; i < 3; i++)
 	{
 		LcdPrintChar(strToPrint[i]);	
 	}
+	
+	LCD_END_BURST();
 }
 
 
@@ -1188,10 +2013,14 @@ void LcdPrintNumericalShort(uint16_t numVal)
 	
 	
 
+	LCD_BEGIN_BURST();
+	
 	for(uint8_t i = 0; i < 5; i++)
 	{
 		LcdPrintChar(strToPrint[i]);	
 	}
+	
+	LCD_END_BURST();
 }
 
 
@@ -1317,12 +2146,16 @@ void LcdPrintNumericalShortAtPosition(uint16_t numVal, unsigned char uchrRow, un
 	strToPrint[4] = (char)fifthValue;
 	
 	
+	LCD_BEGIN_BURST();
+	
 	LcdGoToPosition(uchrRow, uchrColumn);
 	
 	for(uint8_t i = 0; i < 5; i++)
 	{
 		LcdPrintChar(strToPrint[i]);	
 	}
+	
+	LCD_END_BURST();
 }
 
 
@@ -11,6 +11,25 @@
  * LCD_BUSY_FLAG_POSITION as the pin position of the busy flag pin on LCD_DATA_PORT. \n
  * LCD_USE_4_BIT_MODE is used to describe using the LCD in 4 bit mode. This must be defined as 1 to be active. \n
  * If LCD_USE_4_BIT_MODE is selected, pins as LCD_D6, LCD_D5, LCD_D4 must be defined as their respective pin numbers. Since D7 is the same as the busy flag, D7 is not required to be defined. \n
+ * After each write the LCD is given the worst case execution time of that write, LCD_EXECUTION_TIME_US for most commands and data \n
+ * and LCD_CLEAR_HOME_TIME_US for clear display and return home. \n
+ * If RW is wired, define LCD_USE_BUSY_FLAG as 1 to poll the busy flag after each write instead, polling gives up after LCD_BUSY_FLAG_TIMEOUT_US. \n
+ * Defining LCD_USE_SHADOW_BUFFER as 1 has the print and clear functions write into a RAM copy of the screen instead of the LCD, \n
+ * LcdFlush then sends only the characters that differ from what was last sent, with one DD RAM address command for each run of them. \n
+ * The cursor is put back at the current position by LcdFlush. Uses 2 * LCD_ROW_COUNT * LCD_COLUMN_COUNT bytes of RAM and assumes the LCD moves right after each write. \n
+ * Defining LCD_USE_QUEUE as 1 on AVR puts each write after the startup sequence into a ring of LCD_QUEUE_SIZE entries sent by the timer 2 compare A interrupt, \n
+ * one byte or nibble for each interrupt with the timer waiting out each write's execution time, so printing returns straight away unless the ring is full. \n
+ * Global interrupts must be on once LcdInit returns. LcdWaitForQueue waits for everything queued to be done, reads from the LCD wait for it themselves. \n
+ * Timer 2 and the LCD pins belong to the interrupt while it runs and queued writes use the worst case times, not the busy flag. \n
+ * Defining LCD_USE_GLYPH_CACHE as 1 adds LcdGlyphUse and LcdPrintGlyph, which take a glyph ID from 0 to 254 with its 8 byte pattern \n
+ * and upload the pattern only when the glyph isn't already in one of the CG RAM slots from LCD_GLYPH_FIRST_SLOT to 7. \n
+ * When every slot is taken the least recently used glyph is replaced, passing over glyphs still on the screen in the shadow buffer when LCD_USE_SHADOW_BUFFER is 1. \n
+ * Cells showing a replaced glyph show the new one instead, the callback from LcdGlyphSetEvictionCallback gets the ID of each replaced glyph so they can be redrawn. \n
+ * Defining LCD_USE_PCF8574 as 1 drives the LCD in 4 bit mode through a PCF8574 I2C backpack at LCD_PCF8574_ADDRESS instead, using "i2c.h", \n
+ * the port and pin definitions above are then not needed and I2CInit must be called before LcdInit. Each nibble is sent as E high then E low, \n
+ * the time the bus takes covers the execution time of most writes. The string, number, clear line, custom character and LcdFlush functions \n
+ * send all of their writes in one I2C transaction, LcdBeginBurst and LcdEndBurst do the same around any other group of calls. \n
+ * Defining LCD_SIM as 1 builds for the host against the HD44780 emulator in "clcdSim.h", clcdBench.c times the print calls with it. \n
  * To see any ERRORS, define LCD_SHOW_DEFINE_ERRORS as 1
  * \todo Needs to have 4 bit modes tested.
  */ 
@@ -25,6 +44,12 @@ extern "C" {
 //INCLUDES
     
 #include "config.h"
+
+#if defined(LCD_SIM) && LCD_SIM == 1
+//Host build, the emulated controller stands in for the ports and pins
+#include "clcdSim.h"
+#endif
+
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
@@ -56,6 +81,16 @@ extern "C" {
 #endif
 
 
+//Drive the LCD through a PCF8574 I2C backpack instead of the parallel ports
+#ifndef LCD_USE_PCF8574
+#define LCD_USE_PCF8574             0
+#endif
+
+#if LCD_USE_PCF8574 == 1
+#include "i2c.h"
+#endif
+
+
 //ERROR CHECKING
 
 //The amount of columns on the display
@@ -69,6 +104,9 @@ extern "C" {
 #define CLCD_C_ -1
 #undef __INCLUDED_CLCD__
 #endif
+
+//The backpack takes the place of the ports and pins
+#if LCD_USE_PCF8574 != 1
     
 //The output register for the control pins
 #ifndef LCD_CONTROL_PORT
@@ -118,8 +156,101 @@ extern "C" {
 #warning clcd.h: LCD_BUSY_FLAG_POSITION is defaulted to 7, define LCD_BUSY_FLAG_POSITION in config file to change.
 #endif
 
+#endif
+
+//Poll the busy flag after each write instead of waiting the worst case time, needs RW wired
+#ifndef LCD_USE_BUSY_FLAG
+#define LCD_USE_BUSY_FLAG           0
+#endif
+
+//Worst case execution time of data writes and most commands in microseconds, 37us at 270kHz with margin for a slow oscillator
+#ifndef LCD_EXECUTION_TIME_US
+#define LCD_EXECUTION_TIME_US       43
+#endif
+
+//Worst case execution time of clear display and return home in microseconds, 1.52ms at 270kHz with margin for a slow oscillator
+#ifndef LCD_CLEAR_HOME_TIME_US
+#define LCD_CLEAR_HOME_TIME_US      1640
+#endif
+
+//Longest the busy flag is polled before giving up in microseconds, each poll takes at least a microsecond
+#ifndef LCD_BUSY_FLAG_TIMEOUT_US
+#define LCD_BUSY_FLAG_TIMEOUT_US    2000
+#endif
+
+//Print into a RAM copy of the screen and send the changes with LcdFlush
+#ifndef LCD_USE_SHADOW_BUFFER
+#define LCD_USE_SHADOW_BUFFER       0
+#endif
+
+//Queue writes and send them from the timer 2 compare A interrupt so printing doesn't wait on the LCD
+#ifndef LCD_USE_QUEUE
+#define LCD_USE_QUEUE               0
+#endif
+
+//Entries in the output queue, up to 255, each entry is one command or data byte
+#ifndef LCD_QUEUE_SIZE
+#define LCD_QUEUE_SIZE              32
+#endif
+
+//Timer 2 prescaler for the output queue, 8, 32, 64, 128 or 256. Execution times are rounded up to whole ticks
+#ifndef LCD_QUEUE_PRESCALER
+#define LCD_QUEUE_PRESCALER         32
+#endif
+
+//Keep glyphs in the CG RAM slots by ID, uploading each only when it isn't already in a slot
+#ifndef LCD_USE_GLYPH_CACHE
+#define LCD_USE_GLYPH_CACHE         0
+#endif
+
+//First CG RAM slot of the glyph cache, the slots below it are left for LcdStoreCustomCharacter
+#ifndef LCD_GLYPH_FIRST_SLOT
+#define LCD_GLYPH_FIRST_SLOT        0
+#endif
+
+//I2C address of the PCF8574 backpack, usually 0x27, or 0x3F for a PCF8574A
+#ifndef LCD_PCF8574_ADDRESS
+#define LCD_PCF8574_ADDRESS         0x27
+#endif
+
+//Bit position of RS on the backpack, RW is held low
+#ifndef LCD_PCF8574_RS
+#define LCD_PCF8574_RS              0
+#endif
+
+//Bit position of E on the backpack
+#ifndef LCD_PCF8574_E
+#define LCD_PCF8574_E               2
+#endif
+
+//Bit position of the backlight on the backpack
+#ifndef LCD_PCF8574_BACKLIGHT
+#define LCD_PCF8574_BACKLIGHT       3
+#endif
+
+//Bit position of D4 on the backpack, D5 to D7 follow on the next pins
+#ifndef LCD_PCF8574_D4
+#define LCD_PCF8574_D4              4
+#endif
+
+//The backpack is only written to, and the timer interrupt can't share the I2C bus
+#if LCD_USE_PCF8574 == 1 && (LCD_USE_BUSY_FLAG == 1 || LCD_USE_QUEUE == 1)
+    #warning clcd.h: LCD_USE_PCF8574 waits the worst case time after each write and sends straight away, LCD_USE_BUSY_FLAG and LCD_USE_QUEUE are disabled.
+    #undef LCD_USE_BUSY_FLAG
+    #define LCD_USE_BUSY_FLAG 0
+    #undef LCD_USE_QUEUE
+    #define LCD_USE_QUEUE 0
+#endif
+
+//The output queue needs the AVR timer interrupt
+#if LCD_USE_QUEUE == 1 && !defined(__AVR)
+    #warning clcd.h: LCD_USE_QUEUE needs an AVR target, writes are sent straight away.
+    #undef LCD_USE_QUEUE
+    #define LCD_USE_QUEUE 0
+#endif
+
 //If 4 bit mode, the positions of D6, D5, and D4 must be defined
-#if defined(LCD_USE_4_BIT_MODE) && LCD_USE_4_BIT_MODE == 1
+#if defined(LCD_USE_4_BIT_MODE) && LCD_USE_4_BIT_MODE == 1 && LCD_USE_PCF8574 != 1
 #if !defined(LCD_D6) || !defined(LCD_D5) || !defined(LCD_D4)
 #define CLCD_C_ -1
 #undef __INCLUDED_CLCD__
@@ -373,7 +504,9 @@ extern void LcdClearLineAtColumns(unsigned char uchrLine, unsigned char uchrStar
 extern void LcdClearPosition(unsigned char uchrLine, unsigned char uchrColumn);
 extern void LcdStoreDotRow(unsigned char uchrAddress, unsigned char uchrNewDot);
 extern void LcdStoreCustomCharacter(unsigned char uchrAddress, unsigned char auchrCharacter[8]);
+#if LCD_USE_PCF8574 != 1
 extern unsigned char LcdGetAddressCounter();
+#endif
 extern void LcdGoToPosition(unsigned char uchrLine, unsigned char uchrColumn);
 
 extern void LcdSendByte(unsigned char uchrByte);
@@ -408,6 +541,26 @@ extern void LcdPrintNumericalShortDelayAtPosition(uint16_t numVal, unsigned char
 extern void LcdDisplayByteHex(uint8_t byteValue);
 extern void LcdDisplayByteBinary(uint8_t byteValue);
 
+#if LCD_USE_SHADOW_BUFFER == 1
+extern void LcdFlush();
+#endif
+
+#if LCD_USE_QUEUE == 1
+extern void LcdWaitForQueue();
+#endif
+
+#if LCD_USE_GLYPH_CACHE == 1
+extern unsigned char LcdGlyphUse(unsigned char uchrGlyph, const unsigned char auchrPattern[8]);
+extern void LcdPrintGlyph(unsigned char uchrGlyph, const unsigned char auchrPattern[8]);
+extern void LcdGlyphSetEvictionCallback(void (*callback)(unsigned char uchrGlyph));
+#endif
+
+#if LCD_USE_PCF8574 == 1
+extern void LcdBeginBurst();
+extern void LcdEndBurst();
+extern void LcdSetBacklight(bool bOn);
+#endif
+
 
 
 
@@ -425,6 +578,9 @@ extern void LcdDisplayByteBinary(uint8_t byteValue);
 #ifndef LCD_ROW_COUNT
 #error clcd.h: LCD_ROW_COUNT must be defined to use file.
 #endif
+
+//The backpack takes the place of the ports and pins
+#if LCD_USE_PCF8574 != 1
     
 //The output register for the control pins
 #ifndef LCD_CONTROL_PORT
@@ -478,6 +634,8 @@ extern void LcdDisplayByteBinary(uint8_t byteValue);
 
 #endif
 
+#endif
+
 
 #else
 
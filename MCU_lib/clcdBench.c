@@ -0,0 +1,165 @@
+/**
+ * \file clcdBench.c
+ * \author Tim Robbins
+ * \brief Host side benchmarks of the clcd print calls against the HD44780 emulator. \n
+ * Each case prints on a screen cleared before it, LcdFlush is included when LCD_USE_SHADOW_BUFFER is 1. \n
+ * Times are from the emulated clock in LcdSimNanoseconds, so they are what the calls take on the mcu waiting on the LCD. \n
+ * Commands, data, reads, violations, I2C bytes and transactions are from LcdSimGetStats, ok is whether the LCD holds what was printed. \n
+ * BUILD AND RUN, from this folder, with -DLCD_USE_4_BIT_MODE=1, -DLCD_USE_BUSY_FLAG=1 or -DLCD_USE_PCF8574=1 for the other ways of driving the LCD: \n
+ * gcc -std=gnu11 -DLCD_SIM=1 -DLCD_ROW_COUNT=4 -DLCD_COLUMN_COUNT=20 -I. clcdBench.c clcd.c clcdSim.c -o clcdBench && ./clcdBench
+ */
+#include "clcd.h"
+
+#if defined(LCD_SIM) && LCD_SIM == 1
+
+#include <stdio.h>
+
+///A benchmarked print call
+typedef struct
+{
+	const char* name;
+
+	///Characters printed, for characters per second
+	uint16_t characters;
+
+	void (*print)();
+
+	///Checks the LCD holds what was printed, 0 to skip
+	bool (*check)();
+
+} LcdBenchCase;
+
+#if (defined(LCD_USE_4_BIT_MODE) && LCD_USE_4_BIT_MODE == 1) || LCD_USE_PCF8574 == 1
+///Two 8 bit function sets bring the controller into step whatever it was doing, then 4 bit mode
+static unsigned char m_auchrLcdBenchStartup[] = {0x33, 0x32, 0x28, 0x0C, 0x06, 0x01, 0};
+#else
+static unsigned char m_auchrLcdBenchStartup[] = {0x38, 0x0C, 0x06, 0x01, 0};
+#endif
+
+///Rows 2 and 3 carry on from rows 0 and 1 on 4 row displays
+static unsigned char m_auchrLcdBenchLines[4] = {0x00, 0x40, LCD_COLUMN_COUNT, 0x40 + LCD_COLUMN_COUNT};
+
+static unsigned char m_auchrLcdBenchPattern[8] = {0x0E, 0x11, 0x11, 0x1F, 0x1B, 0x1B, 0x1F, 0x00};
+
+
+
+/**
+* \brief Gets the character the fill case prints at a position
+* \param uchrRow The row
+* \param uchrColumn The column
+* \return The character
+*/
+static char LcdBenchFillCharacter(unsigned char uchrRow, unsigned char uchrColumn)
+{
+	return 'A' + (uchrRow * LCD_COLUMN_COUNT + uchrColumn) % 58;
+}
+
+
+
+static void LcdBenchFill()
+{
+	char achrRow[LCD_COLUMN_COUNT + 1];
+
+	for(unsigned char uchrRow = 0; uchrRow < LCD_ROW_COUNT; uchrRow++)
+	{
+		for(unsigned char uchrColumn = 0; uchrColumn < LCD_COLUMN_COUNT; uchrColumn++)
+		{
+			achrRow[uchrColumn] = LcdBenchFillCharacter(uchrRow, uchrColumn);
+		}
+
+		achrRow[LCD_COLUMN_COUNT] = 0;
+		LcdPrintStringAtPosition(achrRow, uchrRow, 0);
+	}
+}
+
+
+
+static bool LcdBenchFillCheck()
+{
+	const uint8_t* puchrDdram = LcdSimGetDdram();
+
+	for(unsigned char uchrRow = 0; uchrRow < LCD_ROW_COUNT; uchrRow++)
+	{
+		for(unsigned char uchrColumn = 0; uchrColumn < LCD_COLUMN_COUNT; uchrColumn++)
+		{
+			if(puchrDdram[m_auchrLcdBenchLines[uchrRow] + uchrColumn] != (uint8_t)LcdBenchFillCharacter(uchrRow, uchrColumn))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+
+
+static void LcdBenchNumber()				{ LcdPrintNumericalShortAtPosition(12345, 1, 0); }
+static bool LcdBenchNumberCheck()			{ return memcmp(LcdSimGetDdram() + m_auchrLcdBenchLines[1], "12345", 5) == 0; }
+static void LcdBenchClear()					{ LcdClearScreen(); LcdPrintChar('x'); }
+static bool LcdBenchClearCheck()			{ return LcdSimGetDdram()[0] == 'x' && LcdSimGetDdram()[1] == ' '; }
+static void LcdBenchCustomCharacter()		{ LcdStoreCustomCharacter(8, m_auchrLcdBenchPattern); }
+static bool LcdBenchCustomCharacterCheck()	{ return memcmp(LcdSimGetCgram() + 8, m_auchrLcdBenchPattern, 8) == 0; }
+
+
+
+static const LcdBenchCase m_aLcdBenchCases[] =
+{
+	{"fill screen", LCD_ROW_COUNT * LCD_COLUMN_COUNT, LcdBenchFill, LcdBenchFillCheck},
+	{"number", 5, LcdBenchNumber, LcdBenchNumberCheck},
+	{"clear and char", 1, LcdBenchClear, LcdBenchClearCheck},
+	{"custom character", 0, LcdBenchCustomCharacter, LcdBenchCustomCharacterCheck}
+};
+
+
+
+/**
+* \brief Runs a case on a cleared screen and prints its figures
+* \param pBenchCase The case
+*/
+static void LcdBenchRun(const LcdBenchCase* pBenchCase)
+{
+	LcdClearScreen();
+
+	#if LCD_USE_SHADOW_BUFFER == 1
+	LcdFlush();
+	#endif
+
+	LcdSimResetStats();
+
+	uint64_t ullStart = LcdSimNanoseconds();
+	pBenchCase->print();
+
+	#if LCD_USE_SHADOW_BUFFER == 1
+	LcdFlush();
+	#endif
+
+	uint64_t ullTime = LcdSimNanoseconds() - ullStart;
+	LcdSimStats stats = LcdSimGetStats();
+	bool bOk = pBenchCase->check == 0 || pBenchCase->check();
+
+	printf("%-18s %10.1f %8lu %8lu %6lu %6lu %6lu %6lu %6lu %4s\n", pBenchCase->name, ullTime / 1000.0,
+		pBenchCase->characters ? (unsigned long)(pBenchCase->characters * 1000000000ULL / ullTime) : 0UL,
+		(unsigned long)stats.commands, (unsigned long)stats.data, (unsigned long)stats.reads,
+		(unsigned long)(stats.violations + stats.setupViolations), (unsigned long)stats.bytes,
+		(unsigned long)stats.transactions, bOk ? "yes" : "NO");
+}
+
+
+
+int main()
+{
+	LcdSimReset();
+	LcdInit(m_auchrLcdBenchStartup, m_auchrLcdBenchLines);
+
+	printf("%-18s %10s %8s %8s %6s %6s %6s %6s %6s %4s\n", "case", "us", "chars/s", "commands", "data", "reads", "viol", "bytes", "trans", "ok");
+
+	for(uint8_t i = 0; i < sizeof(m_aLcdBenchCases) / sizeof(m_aLcdBenchCases[0]); i++)
+	{
+		LcdBenchRun(&m_aLcdBenchCases[i]);
+	}
+
+	return 0;
+}
+
+#endif
@@ -0,0 +1,461 @@
+/**
+ * \file clcdSim.c
+ * \author Tim Robbins
+ * \brief Source file for the host side HD44780 character LCD emulator
+ */
+#include "clcdSim.h"
+
+#if defined(LCD_SIM) && LCD_SIM == 1 && !defined(CLCDSIM_C)
+#define CLCDSIM_C 1
+
+#include "clcd.h"
+#include "i2c.h"
+#include <string.h>
+
+///Nanoseconds for one clock of the emulated I2C bus
+#define LCD_SIM_I2C_CLOCK_NS	(1000000000ULL / F_I2C)
+
+volatile uint8_t lcdSimPorts[4] = {0x00, 0x00, 0x00, 0x00};
+
+static LcdSimStats m_lcdSimStats;
+
+///Emulated time in nanoseconds
+static uint64_t m_ullLcdSimNow = 0;
+
+///Time the controller is busy until
+static uint64_t m_ullLcdSimBusyUntil = 0;
+
+static uint8_t m_auchrLcdSimDdram[LCD_SIM_DDRAM_SIZE];
+static uint8_t m_auchrLcdSimCgram[LCD_SIM_CGRAM_SIZE];
+
+///Address counter, into CG RAM while m_bLcdSimCgMode is set
+static uint8_t m_uchrLcdSimAddress = 0;
+static bool m_bLcdSimCgMode = false;
+
+///Entry mode, the address counter moves right after each write when set
+static bool m_bLcdSimIncrement = true;
+
+///Interface width from the last function set, the controller powers up in 8 bit mode
+static bool m_bLcdSimFourBit = false;
+
+///4 bit mode, set while waiting for the high nibble of a write or read
+static bool m_bLcdSimWriteHigh = true;
+static bool m_bLcdSimReadHigh = true;
+
+///The high nibble of a 4 bit write
+static uint8_t m_uchrLcdSimLatch = 0;
+
+///The control port as last seen by LcdSimSample
+static uint8_t m_uchrLcdSimControl = 0;
+
+///Set from a START addressing the backpack until the STOP
+static bool m_bLcdSimI2COpen = false;
+
+///The backpack's pins as last written
+static uint8_t m_uchrLcdSimPcfPins = 0;
+
+
+
+/**
+* \brief Executes a command or data write
+* \param bIsData If RS was set
+* \param uchrByte The byte
+*/
+static void LcdSimExecute(bool bIsData, uint8_t uchrByte)
+{
+	uint16_t ushtTime = LCD_SIM_EXECUTION_TIME_US; //Time the write keeps the controller busy
+
+	if(m_ullLcdSimNow < m_ullLcdSimBusyUntil)
+	{
+		m_lcdSimStats.violations++;
+	}
+
+	if(bIsData)
+	{
+		m_lcdSimStats.data++;
+
+		if(m_bLcdSimCgMode)
+		{
+			m_auchrLcdSimCgram[m_uchrLcdSimAddress & (LCD_SIM_CGRAM_SIZE - 1)] = uchrByte;
+		}
+		else
+		{
+			m_auchrLcdSimDdram[m_uchrLcdSimAddress & (LCD_SIM_DDRAM_SIZE - 1)] = uchrByte;
+		}
+
+		m_uchrLcdSimAddress += m_bLcdSimIncrement ? 1 : -1;
+	}
+	else
+	{
+		m_lcdSimStats.commands++;
+
+		if(uchrByte & 0x80)
+		{
+			m_uchrLcdSimAddress = uchrByte & 0x7F;
+			m_bLcdSimCgMode = false;
+		}
+		else if(uchrByte & 0x40)
+		{
+			m_uchrLcdSimAddress = uchrByte & 0x3F;
+			m_bLcdSimCgMode = true;
+		}
+		else if(uchrByte & 0x20)
+		{
+			m_bLcdSimFourBit = (uchrByte & 0x10) == 0;
+		}
+		else if(uchrByte & 0x10)
+		{
+			//Cursor shift, moves the address counter unless the display is shifted instead
+			if((uchrByte & 0x08) == 0)
+			{
+				m_uchrLcdSimAddress += (uchrByte & 0x04) ? 1 : -1;
+			}
+		}
+		else if(uchrByte & 0x04)
+		{
+			m_bLcdSimIncrement = (uchrByte & 0x02) != 0;
+		}
+		else if(uchrByte & 0x02)
+		{
+			m_uchrLcdSimAddress = 0;
+			m_bLcdSimCgMode = false;
+			ushtTime = LCD_SIM_CLEAR_HOME_TIME_US;
+		}
+		else if(uchrByte & 0x01)
+		{
+			memset(m_auchrLcdSimDdram, ' ', sizeof(m_auchrLcdSimDdram));
+			m_uchrLcdSimAddress = 0;
+			m_bLcdSimCgMode = false;
+			m_bLcdSimIncrement = true;
+			ushtTime = LCD_SIM_CLEAR_HOME_TIME_US;
+		}
+	}
+
+	m_ullLcdSimBusyUntil = m_ullLcdSimNow + ushtTime * 1000ULL;
+}
+
+
+
+/**
+* \brief Latches the data bus on a fall of E with RW low
+* \param bIsData If RS was set
+* \param uchrBus The data bus, D7 in the top bit. Only D7 to D4 are used in 4 bit mode
+*/
+static void LcdSimLatch(bool bIsData, uint8_t uchrBus)
+{
+	if(!m_bLcdSimFourBit)
+	{
+		m_bLcdSimWriteHigh = true;
+		LcdSimExecute(bIsData, uchrBus);
+	}
+	else if(m_bLcdSimWriteHigh)
+	{
+		m_uchrLcdSimLatch = uchrBus & 0xF0;
+		m_bLcdSimWriteHigh = false;
+	}
+	else
+	{
+		m_bLcdSimWriteHigh = true;
+		LcdSimExecute(bIsData, m_uchrLcdSimLatch | (uchrBus >> 4));
+	}
+}
+
+
+
+/**
+* \brief Gets the data bus as the pins of the data port drive it
+* \return The bus, D7 in the top bit
+*/
+static uint8_t LcdSimDataBus()
+{
+	uint8_t uchrPins = lcdSimPorts[LCD_SIM_DATA];
+
+	#if defined(LCD_USE_4_BIT_MODE) && LCD_USE_4_BIT_MODE == 1
+	//Only D7 to D4 are wired, the rest read as low
+	return (readBit(uchrPins, LCD_BUSY_FLAG_POSITION) << 7) | (readBit(uchrPins, LCD_D6) << 6) |
+		(readBit(uchrPins, LCD_D5) << 5) | (readBit(uchrPins, LCD_D4) << 4);
+	#else
+	return uchrPins;
+	#endif
+}
+
+
+
+/**
+* \brief Sets the read port to what the controller drives, the busy flag and address counter while E is high with RW set
+*/
+static void LcdSimDriveRead()
+{
+	uint8_t uchrControl = lcdSimPorts[LCD_SIM_CONTROL];
+	uint8_t uchrBus = m_uchrLcdSimAddress & 0x7F; //Busy flag and address counter
+
+	if(!(uchrControl & (1 << LCD_RW_PIN)) || !(uchrControl & (1 << LCD_E_PIN)))
+	{
+		lcdSimPorts[LCD_SIM_DATA_READ] = lcdSimPorts[LCD_SIM_DATA];
+		return;
+	}
+
+	if(m_ullLcdSimNow < m_ullLcdSimBusyUntil)
+	{
+		uchrBus |= 0x80;
+	}
+
+	#if defined(LCD_USE_4_BIT_MODE) && LCD_USE_4_BIT_MODE == 1
+	if(!m_bLcdSimReadHigh)
+	{
+		uchrBus <<= 4;
+	}
+
+	lcdSimPorts[LCD_SIM_DATA_READ] = (readBit(uchrBus, 7) << LCD_BUSY_FLAG_POSITION) | (readBit(uchrBus, 6) << LCD_D6) |
+		(readBit(uchrBus, 5) << LCD_D5) | (readBit(uchrBus, 4) << LCD_D4);
+	#else
+	lcdSimPorts[LCD_SIM_DATA_READ] = uchrBus;
+	#endif
+}
+
+
+
+/**
+* \brief Looks at what was written to the control port since it was last seen, latching a write or ending a read when E fell
+*/
+static void LcdSimSample()
+{
+	uint8_t uchrControl = lcdSimPorts[LCD_SIM_CONTROL];
+	uint8_t uchrChanged = uchrControl ^ m_uchrLcdSimControl;
+
+	if(uchrChanged == 0)
+	{
+		return;
+	}
+
+	//RS and RW have to settle before E rises and stay until after it falls
+	if((uchrChanged & (1 << LCD_E_PIN)) && (uchrChanged & (1 << LCD_RS_PIN | 1 << LCD_RW_PIN)))
+	{
+		m_lcdSimStats.setupViolations++;
+	}
+
+	if((m_uchrLcdSimControl & (1 << LCD_E_PIN)) && !(uchrControl & (1 << LCD_E_PIN)))
+	{
+		if(uchrControl & (1 << LCD_RW_PIN))
+		{
+			m_lcdSimStats.reads++;
+
+			#if defined(LCD_USE_4_BIT_MODE) && LCD_USE_4_BIT_MODE == 1
+			m_bLcdSimReadHigh = !m_bLcdSimReadHigh;
+			#endif
+		}
+		else
+		{
+			m_bLcdSimReadHigh = true;
+			LcdSimLatch((uchrControl & (1 << LCD_RS_PIN)) != 0, LcdSimDataBus());
+		}
+	}
+
+	m_uchrLcdSimControl = uchrControl;
+}
+
+
+
+/**
+* \brief Catches up with the writes to the ports since the last access. Used as the index of the emulated ports.
+* \param port The port accessed
+* \return port
+*/
+uint8_t LcdSimTouch(uint8_t port)
+{
+	LcdSimSample();
+
+	if(port == LCD_SIM_DATA_READ)
+	{
+		LcdSimDriveRead();
+	}
+
+	return port;
+}
+
+
+
+/**
+* \brief Resets the controller to its power on state, clears the counters and the clock
+*/
+void LcdSimReset()
+{
+	memset((void*)lcdSimPorts, 0x00, sizeof(lcdSimPorts));
+	memset(m_auchrLcdSimDdram, ' ', sizeof(m_auchrLcdSimDdram));
+	memset(m_auchrLcdSimCgram, 0x00, sizeof(m_auchrLcdSimCgram));
+
+	m_ullLcdSimNow = 0;
+	m_ullLcdSimBusyUntil = 0;
+	m_uchrLcdSimAddress = 0;
+	m_bLcdSimCgMode = false;
+	m_bLcdSimIncrement = true;
+	m_bLcdSimFourBit = false;
+	m_bLcdSimWriteHigh = true;
+	m_bLcdSimReadHigh = true;
+	m_uchrLcdSimControl = 0;
+	m_bLcdSimI2COpen = false;
+	m_uchrLcdSimPcfPins = 0;
+
+	LcdSimResetStats();
+}
+
+
+
+/**
+* \brief Clears the counters
+*/
+void LcdSimResetStats()
+{
+	memset(&m_lcdSimStats, 0x00, sizeof(m_lcdSimStats));
+}
+
+
+
+/**
+* \brief Gets the counters since they were last reset
+* \return The counters
+*/
+LcdSimStats LcdSimGetStats()
+{
+	LcdSimSample();
+	return m_lcdSimStats;
+}
+
+
+
+/**
+* \brief Gets the controller's DD RAM
+* \return The LCD_SIM_DDRAM_SIZE bytes of DD RAM, by address
+*/
+const uint8_t* LcdSimGetDdram()
+{
+	LcdSimSample();
+	return m_auchrLcdSimDdram;
+}
+
+
+
+/**
+* \brief Gets the controller's CG RAM
+* \return The LCD_SIM_CGRAM_SIZE bytes of CG RAM, 8 rows for each character
+*/
+const uint8_t* LcdSimGetCgram()
+{
+	LcdSimSample();
+	return m_auchrLcdSimCgram;
+}
+
+
+
+/**
+* \brief Gets the address counter
+* \return The address counter, into CG RAM after a CG RAM address command
+*/
+uint8_t LcdSimGetAddressCounter()
+{
+	LcdSimSample();
+	return m_uchrLcdSimAddress;
+}
+
+
+
+/**
+* \brief Gets the backlight pin of the backpack
+* \return true if on
+*/
+bool LcdSimGetBacklight()
+{
+	return (m_uchrLcdSimPcfPins & (1 << LCD_PCF8574_BACKLIGHT)) != 0;
+}
+
+
+
+/**
+* \brief Reads the emulated clock, moved on only by the delay functions
+* \return Nanoseconds since LcdSimReset
+*/
+uint64_t LcdSimNanoseconds()
+{
+	return m_ullLcdSimNow;
+}
+
+
+
+/**
+* \brief Moves the emulated clock on, after the writes made before the delay
+* \param ullNanoseconds The time to move on by
+*/
+static void LcdSimWait(uint64_t ullNanoseconds)
+{
+	LcdSimSample();
+	m_ullLcdSimNow += ullNanoseconds;
+}
+
+
+
+/**
+* \brief Emulated I2C start condition and address, only the backpack's address opens a transaction
+* \param i2c_address The address byte
+* \return 0 for no errors
+*/
+uint8_t I2CStart(uint8_t i2c_address)
+{
+	LcdSimWait(LCD_SIM_I2C_CLOCK_NS / 2 + 9 * LCD_SIM_I2C_CLOCK_NS);
+	m_lcdSimStats.bytes++;
+	m_lcdSimStats.transactions++;
+	m_bLcdSimI2COpen = i2c_address == (LCD_PCF8574_ADDRESS << 1);
+	return 0;
+}
+
+
+
+/**
+* \brief Emulated I2C byte, sets the backpack's pins and latches the nibble on D7 to D4 when E falls
+* \param byte The byte
+* \return 0 for no errors
+*/
+uint8_t I2CByte(uint8_t byte)
+{
+	LcdSimWait(9 * LCD_SIM_I2C_CLOCK_NS);
+	m_lcdSimStats.bytes++;
+
+	if(!m_bLcdSimI2COpen)
+	{
+		return 0;
+	}
+
+	uint8_t uchrChanged = byte ^ m_uchrLcdSimPcfPins;
+
+	//RS has to settle before E rises and stay until after it falls
+	if((uchrChanged & (1 << LCD_PCF8574_E)) && (uchrChanged & (1 << LCD_PCF8574_RS)))
+	{
+		m_lcdSimStats.setupViolations++;
+	}
+
+	if((m_uchrLcdSimPcfPins & (1 << LCD_PCF8574_E)) && !(byte & (1 << LCD_PCF8574_E)))
+	{
+		LcdSimLatch((byte & (1 << LCD_PCF8574_RS)) != 0, ((byte >> LCD_PCF8574_D4) & 0x0F) << 4);
+	}
+
+	m_uchrLcdSimPcfPins = byte;
+	return 0;
+}
+
+
+
+/**
+* \brief Emulated I2C stop condition
+*/
+void LcdSimI2CStop()
+{
+	LcdSimWait(LCD_SIM_I2C_CLOCK_NS / 2);
+	m_bLcdSimI2COpen = false;
+}
+
+
+
+void delayForMicroseconds(uint16_t microseconds) { LcdSimWait(microseconds * 1000ULL); }
+void delayForMilliseconds(uint16_t milliseconds) { LcdSimWait(milliseconds * 1000000ULL); }
+void delayForTenthSeconds(uint16_t tenthSeconds) { LcdSimWait(tenthSeconds * 100000000ULL); }
+
+#endif
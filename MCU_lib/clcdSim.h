@@ -0,0 +1,165 @@
+/**
+ * \file clcdSim.h
+ * \author Tim Robbins
+ * \brief Header file for the host side HD44780 character LCD emulator. \n
+ * Stands in for the LCD ports so clcd.c can be built, checked and measured on a pc without a display. \n
+ * REQUIREMENTS: \n
+ * Define LCD_SIM as 1 in "config.h" or on the compiler command line, then build clcd.c and clcdSim.c for the host. \n
+ * The emulator provides the LCD ports, I2CStart, I2CByte, i2c_stop and the mcuDelays functions, so i2c.c and mcuDelays.c are left out. \n
+ * LCD_ROW_COUNT, LCD_COLUMN_COUNT and LCD_USE_4_BIT_MODE are given as usual, the ports and pins default to the emulated ones below. \n
+ * Every access to a port goes through LcdSimTouch, which latches each E fall with the pins as they were, like the controller does. \n
+ * The controller starts in 8 bit mode and follows the function set commands, so 4 bit mode needs the usual 0x33, 0x32 startup. \n
+ * Clear display, return home, entry mode, cursor shift, function set and the CG and DD RAM address commands are decoded, \n
+ * data goes to DD or CG RAM and the busy flag and address counter can be read back with RW high. \n
+ * With LCD_USE_PCF8574 as 1 the controller is driven by a PCF8574 backpack at LCD_PCF8574_ADDRESS on the emulated I2C bus instead, \n
+ * wired as the LCD_PCF8574 pin definitions say with RW held low. Each byte on the bus takes 9 clocks of F_I2C. \n
+ * Time is emulated, the delay functions move it on and each write keeps the controller busy for LCD_SIM_EXECUTION_TIME_US \n
+ * or LCD_SIM_CLEAR_HOME_TIME_US, a write latched while the controller is busy is counted as a violation. \n
+ * clcdBench.c is a host program using the counters and LcdSimNanoseconds to time the print calls.
+ */
+#ifndef CLCDSIM_H_
+#define CLCDSIM_H_ 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "config.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(LCD_SIM) && LCD_SIM == 1
+
+//Time the emulated controller takes for data writes and most commands in microseconds, typical at 270kHz
+#ifndef LCD_SIM_EXECUTION_TIME_US
+#define LCD_SIM_EXECUTION_TIME_US	37
+#endif
+
+//Time the emulated controller takes for clear display and return home in microseconds, typical at 270kHz
+#ifndef LCD_SIM_CLEAR_HOME_TIME_US
+#define LCD_SIM_CLEAR_HOME_TIME_US	1520
+#endif
+
+///Size of the controller's DD RAM address space
+#define LCD_SIM_DDRAM_SIZE			128
+
+///Size of the controller's CG RAM, 8 characters of 8 rows
+#define LCD_SIM_CGRAM_SIZE			64
+
+///Index of each port in lcdSimPorts
+#define LCD_SIM_CONTROL				0
+#define LCD_SIM_DATA				1
+#define LCD_SIM_DATA_DIR			2
+#define LCD_SIM_DATA_READ			3
+
+extern volatile uint8_t lcdSimPorts[4];
+extern uint8_t LcdSimTouch(uint8_t port);
+
+///Every access to a port goes through LcdSimTouch so the emulator sees each edge of E
+#ifndef LCD_CONTROL_PORT
+#define LCD_CONTROL_PORT			lcdSimPorts[LcdSimTouch(LCD_SIM_CONTROL)]
+#endif
+
+#ifndef LCD_DATA_PORT
+#define LCD_DATA_PORT				lcdSimPorts[LcdSimTouch(LCD_SIM_DATA)]
+#endif
+
+#ifndef LCD_DATA_PORT_DIR
+#define LCD_DATA_PORT_DIR			lcdSimPorts[LcdSimTouch(LCD_SIM_DATA_DIR)]
+#endif
+
+#ifndef LCD_DATA_PORT_READ
+#define LCD_DATA_PORT_READ			lcdSimPorts[LcdSimTouch(LCD_SIM_DATA_READ)]
+#endif
+
+#ifndef LCD_E_PIN
+#define LCD_E_PIN					0
+#endif
+
+#ifndef LCD_RS_PIN
+#define LCD_RS_PIN					1
+#endif
+
+#ifndef LCD_RW_PIN
+#define LCD_RW_PIN					2
+#endif
+
+#ifndef LCD_BUSY_FLAG_POSITION
+#define LCD_BUSY_FLAG_POSITION		7
+#endif
+
+#if defined(LCD_USE_4_BIT_MODE) && LCD_USE_4_BIT_MODE == 1
+
+#ifndef LCD_D6
+#define LCD_D6						6
+#endif
+
+#ifndef LCD_D5
+#define LCD_D5						5
+#endif
+
+#ifndef LCD_D4
+#define LCD_D4						4
+#endif
+
+#endif
+
+///Port directions as on AVR, the host has none of its own
+#ifndef FULL_OUTPUT
+#define FULL_OUTPUT					0xFF
+#endif
+
+#ifndef FULL_INPUT
+#define FULL_INPUT					0x00
+#endif
+
+///Bus traffic counted by the emulator
+typedef struct
+{
+	///Commands executed
+	uint32_t commands;
+
+	///Bytes written to DD or CG RAM
+	uint32_t data;
+
+	///Read cycles with RW high, one for each nibble in 4 bit mode
+	uint32_t reads;
+
+	///Writes latched while the controller was still busy
+	uint32_t violations;
+
+	///E rising or falling in the same write that changes RS or RW
+	uint32_t setupViolations;
+
+	///Every byte on the I2C bus, including addresses
+	uint32_t bytes;
+
+	///START conditions on the I2C bus
+	uint32_t transactions;
+
+} LcdSimStats;
+
+extern uint8_t I2CStart(uint8_t i2c_address);
+extern uint8_t I2CByte(uint8_t byte);
+extern void LcdSimI2CStop();
+
+#ifndef i2c_stop
+#define i2c_stop()					LcdSimI2CStop()
+#endif
+
+extern void LcdSimReset();
+extern void LcdSimResetStats();
+extern LcdSimStats LcdSimGetStats();
+extern const uint8_t* LcdSimGetDdram();
+extern const uint8_t* LcdSimGetCgram();
+extern uint8_t LcdSimGetAddressCounter();
+extern bool LcdSimGetBacklight();
+extern uint64_t LcdSimNanoseconds();
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CLCDSIM_H_ */
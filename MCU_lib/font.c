@@ -112,6 +112,351 @@ char ssd1306oled_font_A[] =
 };
 
 
+///ssd1306oled_font_A packed, fixed 6 columns
+const uint8_t ssd1306oled_font_A_packed[] FONT_PACKED_STORAGE =
+{
+	' ', '~', 8, 0,	//First, last, height, spacing
+	FONT_PACKED_OFFSET(0), FONT_PACKED_OFFSET(6), FONT_PACKED_OFFSET(12), FONT_PACKED_OFFSET(18), FONT_PACKED_OFFSET(24), FONT_PACKED_OFFSET(30), FONT_PACKED_OFFSET(36), FONT_PACKED_OFFSET(42),
+	FONT_PACKED_OFFSET(48), FONT_PACKED_OFFSET(54), FONT_PACKED_OFFSET(60), FONT_PACKED_OFFSET(66), FONT_PACKED_OFFSET(72), FONT_PACKED_OFFSET(78), FONT_PACKED_OFFSET(84), FONT_PACKED_OFFSET(90),
+	FONT_PACKED_OFFSET(96), FONT_PACKED_OFFSET(102), FONT_PACKED_OFFSET(108), FONT_PACKED_OFFSET(114), FONT_PACKED_OFFSET(120), FONT_PACKED_OFFSET(126), FONT_PACKED_OFFSET(132), FONT_PACKED_OFFSET(138),
+	FONT_PACKED_OFFSET(144), FONT_PACKED_OFFSET(150), FONT_PACKED_OFFSET(156), FONT_PACKED_OFFSET(162), FONT_PACKED_OFFSET(168), FONT_PACKED_OFFSET(174), FONT_PACKED_OFFSET(180), FONT_PACKED_OFFSET(186),
+	FONT_PACKED_OFFSET(192), FONT_PACKED_OFFSET(198), FONT_PACKED_OFFSET(204), FONT_PACKED_OFFSET(210), FONT_PACKED_OFFSET(216), FONT_PACKED_OFFSET(222), FONT_PACKED_OFFSET(228), FONT_PACKED_OFFSET(234),
+	FONT_PACKED_OFFSET(240), FONT_PACKED_OFFSET(246), FONT_PACKED_OFFSET(252), FONT_PACKED_OFFSET(258), FONT_PACKED_OFFSET(264), FONT_PACKED_OFFSET(270), FONT_PACKED_OFFSET(276), FONT_PACKED_OFFSET(282),
+	FONT_PACKED_OFFSET(288), FONT_PACKED_OFFSET(294), FONT_PACKED_OFFSET(300), FONT_PACKED_OFFSET(306), FONT_PACKED_OFFSET(312), FONT_PACKED_OFFSET(318), FONT_PACKED_OFFSET(324), FONT_PACKED_OFFSET(330),
+	FONT_PACKED_OFFSET(336), FONT_PACKED_OFFSET(342), FONT_PACKED_OFFSET(348), FONT_PACKED_OFFSET(354), FONT_PACKED_OFFSET(360), FONT_PACKED_OFFSET(366), FONT_PACKED_OFFSET(372), FONT_PACKED_OFFSET(378),
+	FONT_PACKED_OFFSET(384), FONT_PACKED_OFFSET(390), FONT_PACKED_OFFSET(396), FONT_PACKED_OFFSET(402), FONT_PACKED_OFFSET(408), FONT_PACKED_OFFSET(414), FONT_PACKED_OFFSET(420), FONT_PACKED_OFFSET(426),
+	FONT_PACKED_OFFSET(432), FONT_PACKED_OFFSET(438), FONT_PACKED_OFFSET(444), FONT_PACKED_OFFSET(450), FONT_PACKED_OFFSET(456), FONT_PACKED_OFFSET(462), FONT_PACKED_OFFSET(468), FONT_PACKED_OFFSET(474),
+	FONT_PACKED_OFFSET(480), FONT_PACKED_OFFSET(486), FONT_PACKED_OFFSET(492), FONT_PACKED_OFFSET(498), FONT_PACKED_OFFSET(504), FONT_PACKED_OFFSET(510), FONT_PACKED_OFFSET(516), FONT_PACKED_OFFSET(522),
+	FONT_PACKED_OFFSET(528), FONT_PACKED_OFFSET(534), FONT_PACKED_OFFSET(540), FONT_PACKED_OFFSET(546), FONT_PACKED_OFFSET(552), FONT_PACKED_OFFSET(558), FONT_PACKED_OFFSET(564), FONT_PACKED_OFFSET(570),
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00,	// sp
+	0x00, 0x00, 0x00, 0x2F, 0x00, 0x00,	// !
+	0x00, 0x00, 0x07, 0x00, 0x07, 0x00,	// "
+	0x00, 0x14, 0x7F, 0x14, 0x7F, 0x14,	// #
+	0x00, 0x24, 0x2A, 0x7F, 0x2A, 0x12,	// $
+	0x00, 0x23, 0x13, 0x08, 0x64, 0x62,	// %
+	0x00, 0x36, 0x49, 0x55, 0x22, 0x50,	// &
+	0x00, 0x00, 0x05, 0x03, 0x00, 0x00,	// '
+	0x00, 0x00, 0x1C, 0x22, 0x41, 0x00,	// (
+	0x00, 0x00, 0x41, 0x22, 0x1C, 0x00,	// )
+	0x00, 0x14, 0x08, 0x3E, 0x08, 0x14,	// *
+	0x00, 0x08, 0x08, 0x3E, 0x08, 0x08,	// +
+	0x00, 0x00, 0x00, 0xA0, 0x60, 0x00,	// ,
+	0x00, 0x08, 0x08, 0x08, 0x08, 0x08,	// -
+	0x00, 0x00, 0x60, 0x60, 0x00, 0x00,	// .
+	0x00, 0x20, 0x10, 0x08, 0x04, 0x02,	// /
+	0x00, 0x3E, 0x51, 0x49, 0x45, 0x3E,	// 0
+	0x00, 0x00, 0x42, 0x7F, 0x40, 0x00,	// 1
+	0x00, 0x42, 0x61, 0x51, 0x49, 0x46,	// 2
+	0x00, 0x21, 0x41, 0x45, 0x4B, 0x31,	// 3
+	0x00, 0x18, 0x14, 0x12, 0x7F, 0x10,	// 4
+	0x00, 0x27, 0x45, 0x45, 0x45, 0x39,	// 5
+	0x00, 0x3C, 0x4A, 0x49, 0x49, 0x30,	// 6
+	0x00, 0x01, 0x71, 0x09, 0x05, 0x03,	// 7
+	0x00, 0x36, 0x49, 0x49, 0x49, 0x36,	// 8
+	0x00, 0x06, 0x49, 0x49, 0x29, 0x1E,	// 9
+	0x00, 0x00, 0x36, 0x36, 0x00, 0x00,	// :
+	0x00, 0x00, 0x56, 0x36, 0x00, 0x00,	// ;
+	0x00, 0x08, 0x14, 0x22, 0x41, 0x00,	// <
+	0x00, 0x14, 0x14, 0x14, 0x14, 0x14,	// =
+	0x00, 0x00, 0x41, 0x22, 0x14, 0x08,	// >
+	0x00, 0x02, 0x01, 0x51, 0x09, 0x06,	// ?
+	0x00, 0x32, 0x49, 0x59, 0x51, 0x3E,	// @
+	0x00, 0x7C, 0x12, 0x11, 0x12, 0x7C,	// A
+	0x00, 0x7F, 0x49, 0x49, 0x49, 0x36,	// B
+	0x00, 0x3E, 0x41, 0x41, 0x41, 0x22,	// C
+	0x00, 0x7F, 0x41, 0x41, 0x22, 0x1C,	// D
+	0x00, 0x7F, 0x49, 0x49, 0x49, 0x41,	// E
+	0x00, 0x7F, 0x09, 0x09, 0x09, 0x01,	// F
+	0x00, 0x3E, 0x41, 0x49, 0x49, 0x7A,	// G
+	0x00, 0x7F, 0x08, 0x08, 0x08, 0x7F,	// H
+	0x00, 0x00, 0x41, 0x7F, 0x41, 0x00,	// I
+	0x00, 0x20, 0x40, 0x41, 0x3F, 0x01,	// J
+	0x00, 0x7F, 0x08, 0x14, 0x22, 0x41,	// K
+	0x00, 0x7F, 0x40, 0x40, 0x40, 0x40,	// L
+	0x00, 0x7F, 0x02, 0x0C, 0x02, 0x7F,	// M
+	0x00, 0x7F, 0x04, 0x08, 0x10, 0x7F,	// N
+	0x00, 0x3E, 0x41, 0x41, 0x41, 0x3E,	// O
+	0x00, 0x7F, 0x09, 0x09, 0x09, 0x06,	// P
+	0x00, 0x3E, 0x41, 0x51, 0x21, 0x5E,	// Q
+	0x00, 0x7F, 0x09, 0x19, 0x29, 0x46,	// R
+	0x00, 0x46, 0x49, 0x49, 0x49, 0x31,	// S
+	0x00, 0x01, 0x01, 0x7F, 0x01, 0x01,	// T
+	0x00, 0x3F, 0x40, 0x40, 0x40, 0x3F,	// U
+	0x00, 0x1F, 0x20, 0x40, 0x20, 0x1F,	// V
+	0x00, 0x3F, 0x40, 0x38, 0x40, 0x3F,	// W
+	0x00, 0x63, 0x14, 0x08, 0x14, 0x63,	// X
+	0x00, 0x07, 0x08, 0x70, 0x08, 0x07,	// Y
+	0x00, 0x61, 0x51, 0x49, 0x45, 0x43,	// Z
+	0x00, 0x00, 0x7F, 0x41, 0x41, 0x00,	// [
+	0x00, 0x55, 0x2A, 0x55, 0x2A, 0x55,	// backslash
+	0x00, 0x00, 0x41, 0x41, 0x7F, 0x00,	// ]
+	0x00, 0x04, 0x02, 0x01, 0x02, 0x04,	// ^
+	0x00, 0x40, 0x40, 0x40, 0x40, 0x40,	// _
+	0x00, 0x00, 0x01, 0x02, 0x04, 0x00,	// `
+	0x00, 0x20, 0x54, 0x54, 0x54, 0x78,	// a
+	0x00, 0x7F, 0x48, 0x44, 0x44, 0x38,	// b
+	0x00, 0x38, 0x44, 0x44, 0x44, 0x20,	// c
+	0x00, 0x38, 0x44, 0x44, 0x48, 0x7F,	// d
+	0x00, 0x38, 0x54, 0x54, 0x54, 0x18,	// e
+	0x00, 0x08, 0x7E, 0x09, 0x01, 0x02,	// f
+	0x00, 0x18, 0xA4, 0xA4, 0xA4, 0x7C,	// g
+	0x00, 0x7F, 0x08, 0x04, 0x04, 0x78,	// h
+	0x00, 0x00, 0x44, 0x7D, 0x40, 0x00,	// i
+	0x00, 0x40, 0x80, 0x84, 0x7D, 0x00,	// j
+	0x00, 0x7F, 0x10, 0x28, 0x44, 0x00,	// k
+	0x00, 0x00, 0x41, 0x7F, 0x40, 0x00,	// l
+	0x00, 0x7C, 0x04, 0x18, 0x04, 0x78,	// m
+	0x00, 0x7C, 0x08, 0x04, 0x04, 0x78,	// n
+	0x00, 0x38, 0x44, 0x44, 0x44, 0x38,	// o
+	0x00, 0xFC, 0x24, 0x24, 0x24, 0x18,	// p
+	0x00, 0x18, 0x24, 0x24, 0x18, 0xFC,	// q
+	0x00, 0x7C, 0x08, 0x04, 0x04, 0x08,	// r
+	0x00, 0x48, 0x54, 0x54, 0x54, 0x20,	// s
+	0x00, 0x04, 0x3F, 0x44, 0x40, 0x20,	// t
+	0x00, 0x3C, 0x40, 0x40, 0x20, 0x7C,	// u
+	0x00, 0x1C, 0x20, 0x40, 0x20, 0x1C,	// v
+	0x00, 0x3C, 0x40, 0x30, 0x40, 0x3C,	// w
+	0x00, 0x44, 0x28, 0x10, 0x28, 0x44,	// x
+	0x00, 0x1C, 0xA0, 0xA0, 0xA0, 0x7C,	// y
+	0x00, 0x44, 0x64, 0x54, 0x4C, 0x44,	// z
+	0x00, 0x00, 0x08, 0x77, 0x00, 0x00,	// {
+	0x00, 0x00, 0x00, 0x7F, 0x00, 0x00,	// |
+	0x00, 0x00, 0x77, 0x08, 0x00, 0x00,	// }
+	0x00, 0x10, 0x08, 0x10, 0x08, 0x00,	// ~
+};
+
+
+///ssd1306oled_font_A packed with the blank columns trimmed, drawn with one column between glyphs
+const uint8_t ssd1306oled_font_A_proportional[] FONT_PACKED_STORAGE =
+{
+	' ', '~', 8, 1,	//First, last, height, spacing
+	FONT_PACKED_OFFSET(0), FONT_PACKED_OFFSET(3), FONT_PACKED_OFFSET(4), FONT_PACKED_OFFSET(7), FONT_PACKED_OFFSET(12), FONT_PACKED_OFFSET(17), FONT_PACKED_OFFSET(22), FONT_PACKED_OFFSET(27),
+	FONT_PACKED_OFFSET(29), FONT_PACKED_OFFSET(32), FONT_PACKED_OFFSET(35), FONT_PACKED_OFFSET(40), FONT_PACKED_OFFSET(45), FONT_PACKED_OFFSET(47), FONT_PACKED_OFFSET(52), FONT_PACKED_OFFSET(54),
+	FONT_PACKED_OFFSET(59), FONT_PACKED_OFFSET(64), FONT_PACKED_OFFSET(67), FONT_PACKED_OFFSET(72), FONT_PACKED_OFFSET(77), FONT_PACKED_OFFSET(82), FONT_PACKED_OFFSET(87), FONT_PACKED_OFFSET(92),
+	FONT_PACKED_OFFSET(97), FONT_PACKED_OFFSET(102), FONT_PACKED_OFFSET(107), FONT_PACKED_OFFSET(109), FONT_PACKED_OFFSET(111), FONT_PACKED_OFFSET(115), FONT_PACKED_OFFSET(120), FONT_PACKED_OFFSET(124),
+	FONT_PACKED_OFFSET(129), FONT_PACKED_OFFSET(134), FONT_PACKED_OFFSET(139), FONT_PACKED_OFFSET(144), FONT_PACKED_OFFSET(149), FONT_PACKED_OFFSET(154), FONT_PACKED_OFFSET(159), FONT_PACKED_OFFSET(164),
+	FONT_PACKED_OFFSET(169), FONT_PACKED_OFFSET(174), FONT_PACKED_OFFSET(177), FONT_PACKED_OFFSET(182), FONT_PACKED_OFFSET(187), FONT_PACKED_OFFSET(192), FONT_PACKED_OFFSET(197), FONT_PACKED_OFFSET(202),
+	FONT_PACKED_OFFSET(207), FONT_PACKED_OFFSET(212), FONT_PACKED_OFFSET(217), FONT_PACKED_OFFSET(222), FONT_PACKED_OFFSET(227), FONT_PACKED_OFFSET(232), FONT_PACKED_OFFSET(237), FONT_PACKED_OFFSET(242),
+	FONT_PACKED_OFFSET(247), FONT_PACKED_OFFSET(252), FONT_PACKED_OFFSET(257), FONT_PACKED_OFFSET(262), FONT_PACKED_OFFSET(265), FONT_PACKED_OFFSET(270), FONT_PACKED_OFFSET(273), FONT_PACKED_OFFSET(278),
+	FONT_PACKED_OFFSET(283), FONT_PACKED_OFFSET(286), FONT_PACKED_OFFSET(291), FONT_PACKED_OFFSET(296), FONT_PACKED_OFFSET(301), FONT_PACKED_OFFSET(306), FONT_PACKED_OFFSET(311), FONT_PACKED_OFFSET(316),
+	FONT_PACKED_OFFSET(321), FONT_PACKED_OFFSET(326), FONT_PACKED_OFFSET(329), FONT_PACKED_OFFSET(333), FONT_PACKED_OFFSET(337), FONT_PACKED_OFFSET(340), FONT_PACKED_OFFSET(345), FONT_PACKED_OFFSET(350),
+	FONT_PACKED_OFFSET(355), FONT_PACKED_OFFSET(360), FONT_PACKED_OFFSET(365), FONT_PACKED_OFFSET(370), FONT_PACKED_OFFSET(375), FONT_PACKED_OFFSET(380), FONT_PACKED_OFFSET(385), FONT_PACKED_OFFSET(390),
+	FONT_PACKED_OFFSET(395), FONT_PACKED_OFFSET(400), FONT_PACKED_OFFSET(405), FONT_PACKED_OFFSET(410), FONT_PACKED_OFFSET(412), FONT_PACKED_OFFSET(413), FONT_PACKED_OFFSET(415), FONT_PACKED_OFFSET(419),
+	0x00, 0x00, 0x00,	// sp
+	0x2F,	// !
+	0x07, 0x00, 0x07,	// "
+	0x14, 0x7F, 0x14, 0x7F, 0x14,	// #
+	0x24, 0x2A, 0x7F, 0x2A, 0x12,	// $
+	0x23, 0x13, 0x08, 0x64, 0x62,	// %
+	0x36, 0x49, 0x55, 0x22, 0x50,	// &
+	0x05, 0x03,	// '
+	0x1C, 0x22, 0x41,	// (
+	0x41, 0x22, 0x1C,	// )
+	0x14, 0x08, 0x3E, 0x08, 0x14,	// *
+	0x08, 0x08, 0x3E, 0x08, 0x08,	// +
+	0xA0, 0x60,	// ,
+	0x08, 0x08, 0x08, 0x08, 0x08,	// -
+	0x60, 0x60,	// .
+	0x20, 0x10, 0x08, 0x04, 0x02,	// /
+	0x3E, 0x51, 0x49, 0x45, 0x3E,	// 0
+	0x42, 0x7F, 0x40,	// 1
+	0x42, 0x61, 0x51, 0x49, 0x46,	// 2
+	0x21, 0x41, 0x45, 0x4B, 0x31,	// 3
+	0x18, 0x14, 0x12, 0x7F, 0x10,	// 4
+	0x27, 0x45, 0x45, 0x45, 0x39,	// 5
+	0x3C, 0x4A, 0x49, 0x49, 0x30,	// 6
+	0x01, 0x71, 0x09, 0x05, 0x03,	// 7
+	0x36, 0x49, 0x49, 0x49, 0x36,	// 8
+	0x06, 0x49, 0x49, 0x29, 0x1E,	// 9
+	0x36, 0x36,	// :
+	0x56, 0x36,	// ;
+	0x08, 0x14, 0x22, 0x41,	// <
+	0x14, 0x14, 0x14, 0x14, 0x14,	// =
+	0x41, 0x22, 0x14, 0x08,	// >
+	0x02, 0x01, 0x51, 0x09, 0x06,	// ?
+	0x32, 0x49, 0x59, 0x51, 0x3E,	// @
+	0x7C, 0x12, 0x11, 0x12, 0x7C,	// A
+	0x7F, 0x49, 0x49, 0x49, 0x36,	// B
+	0x3E, 0x41, 0x41, 0x41, 0x22,	// C
+	0x7F, 0x41, 0x41, 0x22, 0x1C,	// D
+	0x7F, 0x49, 0x49, 0x49, 0x41,	// E
+	0x7F, 0x09, 0x09, 0x09, 0x01,	// F
+	0x3E, 0x41, 0x49, 0x49, 0x7A,	// G
+	0x7F, 0x08, 0x08, 0x08, 0x7F,	// H
+	0x41, 0x7F, 0x41,	// I
+	0x20, 0x40, 0x41, 0x3F, 0x01,	// J
+	0x7F, 0x08, 0x14, 0x22, 0x41,	// K
+	0x7F, 0x40, 0x40, 0x40, 0x40,	// L
+	0x7F, 0x02, 0x0C, 0x02, 0x7F,	// M
+	0x7F, 0x04, 0x08, 0x10, 0x7F,	// N
+	0x3E, 0x41, 0x41, 0x41, 0x3E,	// O
+	0x7F, 0x09, 0x09, 0x09, 0x06,	// P
+	0x3E, 0x41, 0x51, 0x21, 0x5E,	// Q
+	0x7F, 0x09, 0x19, 0x29, 0x46,	// R
+	0x46, 0x49, 0x49, 0x49, 0x31,	// S
+	0x01, 0x01, 0x7F, 0x01, 0x01,	// T
+	0x3F, 0x40, 0x40, 0x40, 0x3F,	// U
+	0x1F, 0x20, 0x40, 0x20, 0x1F,	// V
+	0x3F, 0x40, 0x38, 0x40, 0x3F,	// W
+	0x63, 0x14, 0x08, 0x14, 0x63,	// X
+	0x07, 0x08, 0x70, 0x08, 0x07,	// Y
+	0x61, 0x51, 0x49, 0x45, 0x43,	// Z
+	0x7F, 0x41, 0x41,	// [
+	0x55, 0x2A, 0x55, 0x2A, 0x55,	// backslash
+	0x41, 0x41, 0x7F,	// ]
+	0x04, 0x02, 0x01, 0x02, 0x04,	// ^
+	0x40, 0x40, 0x40, 0x40, 0x40,	// _
+	0x01, 0x02, 0x04,	// `
+	0x20, 0x54, 0x54, 0x54, 0x78,	// a
+	0x7F, 0x48, 0x44, 0x44, 0x38,	// b
+	0x38, 0x44, 0x44, 0x44, 0x20,	// c
+	0x38, 0x44, 0x44, 0x48, 0x7F,	// d
+	0x38, 0x54, 0x54, 0x54, 0x18,	// e
+	0x08, 0x7E, 0x09, 0x01, 0x02,	// f
+	0x18, 0xA4, 0xA4, 0xA4, 0x7C,	// g
+	0x7F, 0x08, 0x04, 0x04, 0x78,	// h
+	0x44, 0x7D, 0x40,	// i
+	0x40, 0x80, 0x84, 0x7D,	// j
+	0x7F, 0x10, 0x28, 0x44,	// k
+	0x41, 0x7F, 0x40,	// l
+	0x7C, 0x04, 0x18, 0x04, 0x78,	// m
+	0x7C, 0x08, 0x04, 0x04, 0x78,	// n
+	0x38, 0x44, 0x44, 0x44, 0x38,	// o
+	0xFC, 0x24, 0x24, 0x24, 0x18,	// p
+	0x18, 0x24, 0x24, 0x18, 0xFC,	// q
+	0x7C, 0x08, 0x04, 0x04, 0x08,	// r
+	0x48, 0x54, 0x54, 0x54, 0x20,	// s
+	0x04, 0x3F, 0x44, 0x40, 0x20,	// t
+	0x3C, 0x40, 0x40, 0x20, 0x7C,	// u
+	0x1C, 0x20, 0x40, 0x20, 0x1C,	// v
+	0x3C, 0x40, 0x30, 0x40, 0x3C,	// w
+	0x44, 0x28, 0x10, 0x28, 0x44,	// x
+	0x1C, 0xA0, 0xA0, 0xA0, 0x7C,	// y
+	0x44, 0x64, 0x54, 0x4C, 0x44,	// z
+	0x08, 0x77,	// {
+	0x7F,	// |
+	0x77, 0x08,	// }
+	0x10, 0x08, 0x10, 0x08,	// ~
+};
+
+
+/**
+ * \brief Gets the height of a packed font
+ * \param font The packed font
+ * \return The height in rows
+ */
+uint8_t FontPackedHeight(const uint8_t* font)
+{
+	return FontPackedRead(&font[2]);
+}
+
+
+
+/**
+ * \brief Gets the blank columns drawn after each glyph of a packed font
+ * \param font The packed font
+ * \return The number of columns
+ */
+uint8_t FontPackedSpacing(const uint8_t* font)
+{
+	return FontPackedRead(&font[3]);
+}
+
+
+
+/**
+ * \brief Finds a glyph of a packed font from the index, without reading its columns
+ * \param font The packed font
+ * \param c The character
+ * \param glyph Filled with where the columns are, the width and the pages
+ * \return true if the font has the character
+ */
+bool FontPackedGetGlyph(const uint8_t* font, char c, FontGlyph* glyph)
+{
+	uint8_t first = FontPackedRead(&font[0]);
+	uint8_t last = FontPackedRead(&font[1]);
+	
+	if((uint8_t)c < first || (uint8_t)c > last)
+	{
+		return false;
+	}
+	
+	const uint8_t* index = &font[FONT_PACKED_HEADER_LENGTH + ((uint8_t)c - first) * 2];
+	uint16_t start = FontPackedRead(&index[0]) | ((uint16_t)FontPackedRead(&index[1]) << 8);
+	uint16_t end = FontPackedRead(&index[2]) | ((uint16_t)FontPackedRead(&index[3]) << 8);
+	
+	glyph->pages = (FontPackedRead(&font[2]) + 7) / 8;
+	glyph->columns = &font[FONT_PACKED_HEADER_LENGTH + (last - first + 2) * 2 + start];
+	glyph->width = (glyph->pages != 0) ? (end - start) / glyph->pages : 0;
+	
+	return true;
+}
+
+
+
+/**
+ * \brief Measures a string in a packed font, characters the font does not have are skipped
+ * \param font The packed font
+ * \param s The string
+ * \return The width in columns, with the spacing between glyphs but not after the last
+ */
+uint16_t FontPackedStringWidth(const uint8_t* font, const char* s)
+{
+	uint8_t spacing = FontPackedSpacing(font);
+	uint16_t width = 0;
+	FontGlyph glyph;
+	
+	while(*s)
+	{
+		if(FontPackedGetGlyph(font, *s++, &glyph))
+		{
+			width += glyph.width + spacing;
+		}
+	}
+	
+	return (width >= spacing) ? width - spacing : 0;
+}
+
+
+
+///Each nibble of a glyph column with every bit repeated 2, 3 and 4 times
+static const uint16_t fontScaleNibbles[FONT_SCALE_MAX - 1][16] FONT_PACKED_STORAGE =
+{
+	{0x0000, 0x0003, 0x000C, 0x000F, 0x0030, 0x0033, 0x003C, 0x003F,
+	 0x00C0, 0x00C3, 0x00CC, 0x00CF, 0x00F0, 0x00F3, 0x00FC, 0x00FF},
+	{0x0000, 0x0007, 0x0038, 0x003F, 0x01C0, 0x01C7, 0x01F8, 0x01FF,
+	 0x0E00, 0x0E07, 0x0E38, 0x0E3F, 0x0FC0, 0x0FC7, 0x0FF8, 0x0FFF},
+	{0x0000, 0x000F, 0x00F0, 0x00FF, 0x0F00, 0x0F0F, 0x0FF0, 0x0FFF,
+	 0xF000, 0xF00F, 0xF0F0, 0xF0FF, 0xFF00, 0xFF0F, 0xFFF0, 0xFFFF}
+};
+
+#if defined(__AVR)
+#define FontScaleRead(p)			pgm_read_word(p)
+#else
+#define FontScaleRead(p)			(*(p))
+#endif
+
+
+
+/**
+ * \brief Scales a glyph column up, each row becomes scale rows, with one table lookup per nibble
+ * \param column The column, top row in bit 0
+ * \param scale The factor, 2 to FONT_SCALE_MAX, anything else returns the column as is
+ * \return The scaled column, top row in bit 0, byte n is the column of the nth page down
+ */
+uint32_t FontScaleColumn(uint8_t column, uint8_t scale)
+{
+	if(scale < 2 || scale > FONT_SCALE_MAX)
+	{
+		return column;
+	}
+	
+	const uint16_t* nibbles = fontScaleNibbles[scale - 2];
+	
+	return FontScaleRead(&nibbles[column & 0x0F]) | ((uint32_t)FontScaleRead(&nibbles[column >> 4]) << (scale * 4));
+}
+
+
 uint8_t AtechLogoA_3x19_Font[57] = 
 {
 	0b00000000,0b00000000,0b11111110,
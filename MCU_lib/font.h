@@ -22,9 +22,6 @@ extern "C" {
 extern const uint8_t ATECH_LOGO[] PROGMEM;
 extern uint8_t BIG_NUMBERS[11][57];
 
-#define FONT_BIG_NUM_WIDTH	24
-#define FONT_BIG_NUM_HEIGHT 19
-
 
 #elif defined(__XC)
 
@@ -44,6 +41,9 @@ extern uint8_t BIG_NUMBERS[11][57];
     
 #endif
 
+#include <stdint.h>
+#include <stdbool.h>
+
 
 #define ssd1306oled_font_A_length		95
 #define ssd1306oled_font_A_char_length	6
@@ -51,9 +51,59 @@ extern char ssd1306oled_font_A[];
 extern uint8_t AtechLogoA_3x19_Font[57];
 
 
+
+/**
+ * Packed fonts live in flash and are read a byte at a time, a glyph is never copied to ram. \n
+ * Byte 0 is the first character, byte 1 the last, byte 2 the height in rows and byte 3 the blank columns drawn after each glyph. \n
+ * Then come last-first+2 little endian offsets of each glyph into the glyph data, the extra one being the end of the data. \n
+ * Each glyph is its columns for the top page followed by the columns of each page below, \n
+ * so its width is the difference between its offset and the next divided by the pages, and finding a glyph is one index lookup.
+ */
+#define FONT_PACKED_HEADER_LENGTH	4
+
+///Writes an offset of the index as its two bytes
+#define FONT_PACKED_OFFSET(o)		(uint8_t)((o) & 0xFF), (uint8_t)((o) >> 8)
+
+#if defined(__AVR)
+#define FONT_PACKED_STORAGE			PROGMEM
+#define FontPackedRead(p)			pgm_read_byte(p)
+#else
+///const tables are already kept in program memory on the PIC compilers
+#define FONT_PACKED_STORAGE
+#define FontPackedRead(p)			(*(const uint8_t*)(p))
+#endif
+
+///A glyph of a packed font, its columns are still in flash
+typedef struct
+{
+	const uint8_t* columns;
+	uint8_t width;
+	uint8_t pages;
+} FontGlyph;
+
+extern const uint8_t ssd1306oled_font_A_packed[] FONT_PACKED_STORAGE;
+extern const uint8_t ssd1306oled_font_A_proportional[] FONT_PACKED_STORAGE;
+
+extern uint8_t FontPackedHeight(const uint8_t* font);
+extern uint8_t FontPackedSpacing(const uint8_t* font);
+extern bool FontPackedGetGlyph(const uint8_t* font, char c, FontGlyph* glyph);
+extern uint16_t FontPackedStringWidth(const uint8_t* font, const char* s);
+
+
+
+///Largest factor FontScaleColumn scales by
+#define FONT_SCALE_MAX				4
+
+extern uint32_t FontScaleColumn(uint8_t column, uint8_t scale);
+
+
 #define ATECH_LOGO_WIDTH	80
 #define ATECH_LOGO_HEIGHT	19
 
+///Size of a BIG_NUMBERS glyph, rows of 3 bytes with the leftmost pixel in the top bit. Glyph 10 is a minus sign.
+#define FONT_BIG_NUM_WIDTH	24
+#define FONT_BIG_NUM_HEIGHT 19
+
 #define BIG_NUMS_WIDTH		24
 #define BIG_NUMS_HEIGHT		19
 
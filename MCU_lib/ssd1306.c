@@ -12,32 +12,435 @@
 
 #include <string.h>
 
+#if SSD1306_USE_ASYNC == 1
+
+#include <avr/interrupt.h>
+
+///Holds off a blocking transfer until the interrupt driven transfer is done with the bus
+#define SSD1306_WAIT_FOR_BUS()	SSD1306WaitForTransfer()
+
+#else
+
+#define SSD1306_WAIT_FOR_BUS()
+
+#endif
+
+#if SSD1306_STRIP_MODE != 1
+
+//Draw calls always draw straight away outside of strip mode
+#define SSD1306_RECORD_DRAW(op, ...)
+
+#define SSD1306_RECORD_WRITE(op, ...)
+
+#endif
+
+static const uint8_t ssd1306csPinPositions[] =
+{
+  SSD1306_CS_PIN_POSITIONS  
+};
+
+static uint8_t currentDisplay = 0;
+
+///Chip select bits the transfers drive, the selected display or every display when broadcasting
+static uint8_t ssd1306csMask = 0;
+
 #if !defined(SSD1306_DRAW_IMMEDIATE) || SSD1306_DRAW_IMMEDIATE < 1
 
+#if defined(SSD1306_DISPLAY_HEIGHTS)
+
+///Pages in the buffers, every display's pages back to back
+#define SSD1306_BUFFER_PAGES	(SSD1306_TOTAL_HEIGHT/8)
+
+///Height of each display, in the same order as SSD1306_CS_PIN_POSITIONS
+static const uint8_t ssd1306DisplayHeights[] = { SSD1306_DISPLAY_HEIGHTS };
+
+///Pages of the selected display
+static uint8_t ssd1306DisplayPages = SSD1306_HEIGHT/8;
+
+///Page count of the selected display
+#define SSD1306_PAGES			ssd1306DisplayPages
+
+#else
+
+#define SSD1306_BUFFER_PAGES	(SSD1306_HEIGHT/8)
+
+///Page count of the display
+#define SSD1306_PAGES			(SSD1306_HEIGHT/8)
+
+#endif
+
+#if SSD1306_STRIP_MODE == 1
+
+///Page value of ssd1306StripPage while calls are recorded, no page gets drawn
+#define SSD1306_STRIP_NO_PAGE	0xFF
+
+///The one page of the display being drawn
+static uint8_t ssd1306Strip[SSD1306_WIDTH];
+
+///The page ssd1306Strip holds
+static uint8_t ssd1306StripPage = SSD1306_STRIP_NO_PAGE;
+
+///Recorded draw calls
+static uint8_t ssd1306DisplayList[SSD1306_DISPLAY_LIST_SIZE];
+
+///Bytes used in the display list
+static uint16_t ssd1306DisplayListLength = 0;
+
+///Set when the list ran out of room and a call was dropped
+static bool ssd1306DisplayListOverflow = false;
+
+///Set when the list changed since the last update
+static bool ssd1306DisplayListChanged = true;
+
+///Set while the list is replayed, so the draw calls draw instead of recording
+static bool ssd1306Replaying = false;
+
+#elif SSD1306_DOUBLE_BUFFER == 1
+
+///Front and back buffers
+static uint8_t ssd1306FrameBuffers[2][SSD1306_BUFFER_PAGES][SSD1306_WIDTH];
+
+///The back buffer, everything draws into this one
+static uint8_t (*SSD1306DisplayBuffer)[SSD1306_WIDTH] = ssd1306FrameBuffers[0];
+
+///The front buffer, the one last handed to the display
+static uint8_t (*ssd1306SendBuffer)[SSD1306_WIDTH] = ssd1306FrameBuffers[1];
+
+#if defined(SSD1306_DISPLAY_HEIGHTS)
+
+///Which of the two buffers is the front one for each display
+static uint8_t ssd1306FrontBuffer[sizeof(ssd1306DisplayHeights)];
+
+#endif
+
+#elif defined(SSD1306_DISPLAY_HEIGHTS)
+
+///Every display's buffer
+static uint8_t ssd1306FrameBuffers[1][SSD1306_BUFFER_PAGES][SSD1306_WIDTH];
+
+///The selected display's part of the buffer
+static uint8_t (*SSD1306DisplayBuffer)[SSD1306_WIDTH] = ssd1306FrameBuffers[0];
+
+///Drawing and sending share the one buffer
+#define ssd1306SendBuffer SSD1306DisplayBuffer
+
+#else
+
 static uint8_t SSD1306DisplayBuffer[SSD1306_HEIGHT/8][SSD1306_WIDTH]; //Current max possible size, maybe need to fix this?
 
+///Drawing and sending share the one buffer
+#define ssd1306SendBuffer SSD1306DisplayBuffer
+
+#endif
+
+#if SSD1306_STRIP_MODE == 1
+
+//Every strip is sent whole, nothing to track
+
+#elif defined(SSD1306_DISPLAY_HEIGHTS)
+
+///Dirty span starts of every display's pages
+static uint8_t ssd1306DirtyStarts[SSD1306_BUFFER_PAGES];
+
+///Dirty span ends of every display's pages
+static uint8_t ssd1306DirtyEnds[SSD1306_BUFFER_PAGES];
+
+///The first changed column of each page of the selected display. SSD1306_WIDTH when the page is clean
+static uint8_t* ssd1306DirtyStart = ssd1306DirtyStarts;
+
+///One past the last changed column of each page of the selected display. 0 when the page is clean
+static uint8_t* ssd1306DirtyEnd = ssd1306DirtyEnds;
+
+#else
+
+///The first changed column of each page since the last update. SSD1306_WIDTH when the page is clean
+static uint8_t ssd1306DirtyStart[SSD1306_HEIGHT/8];
+
+///One past the last changed column of each page since the last update. 0 when the page is clean
+static uint8_t ssd1306DirtyEnd[SSD1306_HEIGHT/8];
+
+#endif
+
+
+
+/**
+* \brief Widens the dirty span of the page passed to include the columns passed
+* \param page The page of the buffer that changed
+* \param startX The first column that changed
+* \param endX One past the last column that changed
+*/
+static inline void SSD1306MarkDirty(uint8_t page, uint8_t startX, uint8_t endX)
+{
+#if SSD1306_STRIP_MODE != 1
+	if(startX < ssd1306DirtyStart[page]) ssd1306DirtyStart[page] = startX;
+	if(endX > ssd1306DirtyEnd[page]) ssd1306DirtyEnd[page] = endX;
+#else
+	(void)page;
+	(void)startX;
+	(void)endX;
+#endif
+}
+
+
+
+/**
+* \brief Resets the dirty spans of every page to clean
+*/
+static inline void SSD1306ClearDirty()
+{
+#if SSD1306_STRIP_MODE == 1
+	ssd1306DisplayListChanged = false;
+#else
+	for(uint8_t page = 0; page < SSD1306_PAGES; page++)
+	{
+		ssd1306DirtyStart[page] = SSD1306_WIDTH;
+		ssd1306DirtyEnd[page] = 0;
+	}
+#endif
+}
+
+
+
+/**
+* \brief Gets a page of the buffer to draw into
+* \param page The page, no bounds checks
+* \return The page's bytes, or 0 in strip mode when the page isn't the one being drawn
+*/
+static inline uint8_t* SSD1306BufferRow(uint8_t page)
+{
+#if SSD1306_STRIP_MODE == 1
+	return (page == ssd1306StripPage) ? ssd1306Strip : 0;
+#else
+	return SSD1306DisplayBuffer[page];
+#endif
+}
+
+
+
+/**
+* \brief Writes a byte into the buffer, marking it dirty only if the value changed. No bounds checks.
+* \param page The page of the buffer
+* \param x The column of the buffer
+* \param data The new byte
+*/
+static inline void SSD1306BufferWrite(uint8_t page, uint8_t x, uint8_t data)
+{
+	uint8_t* row = SSD1306BufferRow(page);
+	
+	if(row != 0 && row[x] != data)
+	{
+		row[x] = data;
+		SSD1306MarkDirty(page, x, x+1);
+	}
+}
+
+
+
+#if SSD1306_STRIP_MODE == 1
+
+///Display list opcodes, each followed by its argument bytes
+#define SSD1306_OP_PIXEL			0
+#define SSD1306_OP_LINE				1
+#define SSD1306_OP_RECT				2
+#define SSD1306_OP_FILL_RECT		3
+#define SSD1306_OP_CIRCLE			4
+#define SSD1306_OP_FILL_CIRCLE		5
+#define SSD1306_OP_BITMAP			6
+#define SSD1306_OP_AREA				7
+#define SSD1306_OP_WRITE			8
+#define SSD1306_OP_PUT_CHAR			9
+#define SSD1306_OP_FONT_CHAR		10
+#define SSD1306_OP_FONT_STRING		11
+#define SSD1306_OP_FONT_STRING_AT	12
+#define SSD1306_OP_FONT_LINE		13
+#define SSD1306_OP_FONT_AT			14
+#define SSD1306_OP_FONT_DRAW		15
+#define SSD1306_OP_SPRITE			16
+#define SSD1306_OP_PACKED_STRING	17
+#define SSD1306_OP_SCALED_STRING	18
+
+///Bytes a pointer takes in the display list
+#define SSD1306_OP_POINTER			sizeof(void*)
+
+///Argument bytes of each opcode, string opcodes are followed by a length byte and the terminated characters
+static const uint8_t ssd1306OpLengths[] =
+{
+	3, 5, 5, 5, 4, 4,
+	5 + SSD1306_OP_POINTER, 5 + SSD1306_OP_POINTER,
+	3, 3,
+	4 + SSD1306_OP_POINTER, 3 + SSD1306_OP_POINTER, 3 + SSD1306_OP_POINTER, 3 + SSD1306_OP_POINTER, 4 + SSD1306_OP_POINTER,
+	4 + SSD1306_OP_POINTER, 8 + SSD1306_OP_POINTER, 2 + SSD1306_OP_POINTER, 5 + SSD1306_OP_POINTER
+};
+
+
+
+/**
+* \brief Adds a call to the display list
+* \param op The opcode
+* \param args The argument bytes, ssd1306OpLengths[op] of them
+* \param s String to copy in after the arguments, or 0
+*/
+static void SSD1306ListAdd(uint8_t op, const uint8_t* args, const char* s)
+{
+	uint8_t length = ssd1306OpLengths[op];
+	uint8_t stringLength = (s != 0) ? (uint8_t)min(strlen(s), 254) : 0;
+	uint16_t needed = 1 + length + ((s != 0) ? 2 + stringLength : 0);
+	
+	if(ssd1306DisplayListLength + needed > SSD1306_DISPLAY_LIST_SIZE)
+	{
+		ssd1306DisplayListOverflow = true;
+		return;
+	}
+	
+	uint8_t* at = &ssd1306DisplayList[ssd1306DisplayListLength];
+	
+	*at++ = op;
+	memcpy(at, args, length);
+	at += length;
+	
+	if(s != 0)
+	{
+		//Keep the terminator so the string can be drawn straight from the list
+		*at++ = stringLength;
+		memcpy(at, s, stringLength);
+		at[stringLength] = '\0';
+	}
+	
+	ssd1306DisplayListLength += needed;
+	ssd1306DisplayListChanged = true;
+}
+
+
+
+/**
+* \brief Empties the display list
+*/
+static void SSD1306ListReset()
+{
+	ssd1306DisplayListLength = 0;
+	ssd1306DisplayListOverflow = false;
+	ssd1306DisplayListChanged = true;
+}
+
+
+
+/**
+* \brief Checks if a draw call was dropped because the display list was full since it was last cleared
+* \return true if the list overflowed
+*/
+bool SSD1306DisplayListFull()
+{
+	return ssd1306DisplayListOverflow;
+}
+
+
+
+///Records a draw call that returns a result instead of drawing it, the call is drawn when the strips are
+#define SSD1306_RECORD_DRAW(op, ...)	if(!ssd1306Replaying) { uint8_t recordArgs[] = {__VA_ARGS__}; SSD1306ListAdd(op, recordArgs, 0); return 0; }
+
+///Records a draw call with no result instead of drawing it
+#define SSD1306_RECORD_WRITE(op, ...)	if(!ssd1306Replaying) { uint8_t recordArgs[] = {__VA_ARGS__}; SSD1306ListAdd(op, recordArgs, 0); return; }
+
+#endif
+
+
+
 /**
 * \brief Writes directly to the buffer
-*
+* \param data The byte to write
+* \param x The column to write at
+* \param y The page to write at
 */
 void SSD1306WriteToBuffer(uint8_t data, unsigned char x, unsigned char y)
 {
-	if(y < SSD1306_HEIGHT && x < SSD1306_WIDTH)
+	SSD1306_RECORD_WRITE(SSD1306_OP_WRITE, data, x, y);
+	
+	if(y < SSD1306_PAGES && x < SSD1306_WIDTH)
 	{
-		SSD1306DisplayBuffer[y][x] = data;
+		SSD1306BufferWrite(y, x, data);
 	}
 }
 
+
+
+/**
+* \brief Marks the entire buffer as changed so the next update sends every byte. Use when the display ram no longer matches the buffer.
+*/
+void SSD1306InvalidateBuffer()
+{
+#if SSD1306_STRIP_MODE == 1
+	ssd1306DisplayListChanged = true;
+#else
+	for(uint8_t page = 0; page < SSD1306_PAGES; page++)
+	{
+		ssd1306DirtyStart[page] = 0;
+		ssd1306DirtyEnd[page] = SSD1306_WIDTH;
+	}
 #endif
+}
 
-static uint16_t cursorPosX = 0;
-static uint16_t cursorPosY = 0;
-static const uint8_t ssd1306csPinPositions[] =
+
+
+#if SSD1306_DOUBLE_BUFFER == 1
+
+/**
+* \brief Makes the back buffer the front buffer and copies the changed spans into the new back buffer so both match again. \n
+* Waits for any transfer still reading the old front buffer. The dirty spans are left for the transfer to send.
+*/
+static void SSD1306PresentBackBuffer()
 {
-  SSD1306_CS_PIN_POSITIONS  
-};
+	SSD1306_WAIT_FOR_BUS();
+	
+	uint8_t (*presented)[SSD1306_WIDTH] = SSD1306DisplayBuffer;
+	
+	SSD1306DisplayBuffer = ssd1306SendBuffer;
+	ssd1306SendBuffer = presented;
+	
+#if defined(SSD1306_DISPLAY_HEIGHTS)
+	ssd1306FrontBuffer[currentDisplay] ^= 1;
+#endif
+	
+	for(uint8_t page = 0; page < SSD1306_PAGES; page++)
+	{
+		if(ssd1306DirtyStart[page] < ssd1306DirtyEnd[page])
+		{
+			memcpy(&SSD1306DisplayBuffer[page][ssd1306DirtyStart[page]], &presented[page][ssd1306DirtyStart[page]], ssd1306DirtyEnd[page] - ssd1306DirtyStart[page]);
+		}
+	}
+}
+
+#endif
+
+
+
+#endif
+
 
-static uint8_t currentDisplay = 0;
+
+/**
+* \brief Sets the column and page window that following data is written into
+* \param startX The first column of the window
+* \param endX The last column of the window
+* \param startPage The first page of the window
+* \param endPage The last page of the window
+*/
+static void SSD1306SetAddressWindow(uint8_t startX, uint8_t endX, uint8_t startPage, uint8_t endPage)
+{
+	uint8_t commandSequence[6] = {SSD1306_SET_COLUMN_ADDR, startX, endX, SSD1306_SET_PAGE_RANGE, startPage, endPage};
+	SSD1306SendCommandArray(commandSequence, sizeof(commandSequence));
+}
+
+
+#ifndef SSD1306_PAGES
+
+///Page count of the display
+#define SSD1306_PAGES			(SSD1306_HEIGHT/8)
+
+#endif
+
+
+static uint16_t cursorPosX = 0;
+static uint16_t cursorPosY = 0;
 
 /**
  * Selects the currently active display from the display array
@@ -45,6 +448,9 @@ static uint8_t currentDisplay = 0;
  */
 void SSD1306SelectDisplay(uint8_t display)
 {
+    //Queued bytes belong to the display selected when they were queued
+    SSD1306Flush();
+    
     if(display < sizeof(ssd1306csPinPositions))
     {
         currentDisplay = display;
@@ -53,6 +459,31 @@ void SSD1306SelectDisplay(uint8_t display)
     {
         currentDisplay = 0;
     }
+    
+    ssd1306csMask = (1 << ssd1306csPinPositions[currentDisplay]);
+    
+#if defined(SSD1306_DISPLAY_HEIGHTS)
+    
+    //Find the selected display's pages in the shared buffers
+    uint8_t pageOffset = 0;
+    
+    for(uint8_t i = 0; i < currentDisplay; i++)
+    {
+        pageOffset += ssd1306DisplayHeights[i]/8;
+    }
+    
+    ssd1306DisplayPages = ssd1306DisplayHeights[currentDisplay]/8;
+    ssd1306DirtyStart = &ssd1306DirtyStarts[pageOffset];
+    ssd1306DirtyEnd = &ssd1306DirtyEnds[pageOffset];
+    
+#if SSD1306_DOUBLE_BUFFER == 1
+    SSD1306DisplayBuffer = &ssd1306FrameBuffers[!ssd1306FrontBuffer[currentDisplay]][pageOffset];
+    ssd1306SendBuffer = &ssd1306FrameBuffers[ssd1306FrontBuffer[currentDisplay]][pageOffset];
+#else
+    SSD1306DisplayBuffer = &ssd1306FrameBuffers[0][pageOffset];
+#endif
+    
+#endif
 }
 
 
@@ -76,16 +507,22 @@ void SSD1306Initialize(bool displayOn, uint8_t currentDisplaySelection)
 	//SSD1306ClearBuffer();
 	
 	//Make sure buffer is cleared and initialized
-	for(uint8_t y = 0, x = 0; y < SSD1306_HEIGHT; x++)
+#if defined(SSD1306_DISPLAY_HEIGHTS)
+	//Point at the start of the buffers so every display gets cleared
+	SSD1306SelectDisplay(0);
+#endif
+	
+#if SSD1306_STRIP_MODE == 1
+	SSD1306ListReset();
+#else
+	for(uint8_t page = 0; page < SSD1306_BUFFER_PAGES; page++)
 	{
-		
-		if(x >= SSD1306_WIDTH)
-		{
-			x = 0;
-			y++;
-		}
-		SSD1306DisplayBuffer[y][x] = 0;
+		memset(SSD1306DisplayBuffer[page], 0x00, SSD1306_WIDTH);
+		memset(ssd1306SendBuffer[page], 0x00, SSD1306_WIDTH);
+		ssd1306DirtyStart[page] = SSD1306_WIDTH;
+		ssd1306DirtyEnd[page] = 0;
 	}
+#endif
 	
 	#endif
     
@@ -151,6 +588,12 @@ void SSD1306Initialize(bool displayOn, uint8_t currentDisplaySelection)
 	{
 		SSD1306SelectDisplay(i);
 		
+#if defined(SSD1306_DISPLAY_HEIGHTS)
+		//Multiplex ratio and com pins for this display's height
+		init_sequence[13] = ssd1306DisplayHeights[i]-1;
+		init_sequence[22] = (ssd1306DisplayHeights[i] == 32) ? 0x02 : 0x12;
+#endif
+		
 		//SSD1306_CS_PORT &= ~(1 << ssd1306csPinPositions[i]);
 		//Send our initialization sequence
 		SSD1306SendCommandArray(init_sequence, sizeof(init_sequence));
@@ -170,6 +613,7 @@ void SSD1306Initialize(bool displayOn, uint8_t currentDisplaySelection)
 	//Clear the OLED screen and deactivate any scrolling
 	SSD1306ClearScreen();
 	SSD1306SendCommand(SSD1306_CMD_DEACTIVATE_SCROLL);
+	SSD1306Flush();
     
 	#endif
 	
@@ -179,42 +623,254 @@ void SSD1306Initialize(bool displayOn, uint8_t currentDisplaySelection)
   
 
 
+#if SSD1306_USE_QUEUE == 1
+
+///Bytes waiting to go out in the next transaction
+static uint8_t ssd1306Queue[SSD1306_QUEUE_SIZE];
+
+///One bit per queued byte, set for data and clear for commands
+static uint8_t ssd1306QueueIsData[(SSD1306_QUEUE_SIZE+7)/8];
+
+///Number of bytes in the queue
+static uint8_t ssd1306QueueLength = 0;
+
+
+
 /**
- * Sends a single command to the display. Chip select must be set before running this
- * \param cmd
- */
-void SSD1306SendCommand(uint8_t cmd)
+* \brief Checks if a queued byte is data or a command
+* \param i The index of the byte in the queue
+* \return true if data
+*/
+static inline bool SSD1306QueuedIsData(uint8_t i)
 {
-#if SSD1306_SPI == 1
-    
-	SSD1306_CS_PORT &= ~(1 << ssd1306csPinPositions[currentDisplay]);
-    SSD1306_CLEAR_DC();
-    SpiTransmit(cmd);
-    SSD1306_SET_DC();
-    SSD1306_CS_PORT |= (1 << ssd1306csPinPositions[currentDisplay]);
-	
-#elif SSD1306_I2C == 1
-    I2CStart((SSD1306_ADDRESS << 1) | 0);
-    I2CByte(SSD1306_CMD_SEND_CMD);    // 0x00 for command, 0x40 for data
-    I2CByte(cmd);
-    i2c_stop();
-#endif
+	return (ssd1306QueueIsData[i >> 3] & (1 << (i & 7))) != 0;
 }
 
 
 
 /**
- * Sends commands to the display. Chip select must be set before running this
- * \param cmd
- */
-void SSD1306SendMoreCommands(uint8_t* cmd)
+* \brief Sends the queue followed by the bytes passed in a single chip select window. \n
+* On I2C a run of one or two bytes gets a 0x80/0xC0 control byte each so it can share the transaction,
+* longer runs and the last run stream after a single 0x00/0x40 control byte.
+* \param bytes Bytes to send after the queue
+* \param length The number of bytes passed, 0 to only send the queue
+* \param isData If the bytes passed are data
+*/
+static void SSD1306QueueTransfer(const uint8_t* bytes, uint16_t length, bool isData)
 {
+	if(ssd1306QueueLength == 0 && length == 0)
+	{
+		return;
+	}
+	
 #if SSD1306_SPI == 1
-    SSD1306_CS_PORT &= ~(1 << ssd1306csPinPositions[currentDisplay]);
+
+	SSD1306_CS_PORT &= ~ssd1306csMask;
+	
+	for(uint8_t i = 0; i < ssd1306QueueLength; i++)
+	{
+		if(SSD1306QueuedIsData(i))
+		{
+			SSD1306_SET_DC();
+		}
+		else
+		{
+			SSD1306_CLEAR_DC();
+		}
+		
+		SpiTransmit(ssd1306Queue[i]);
+	}
+	
+	if(isData)
+	{
+		SSD1306_SET_DC();
+	}
+	else
+	{
+		SSD1306_CLEAR_DC();
+	}
+	
+	for(uint16_t i = 0; i < length; i++)
+	{
+		SpiTransmit(bytes[i]);
+	}
+	
+	SSD1306_SET_DC();
+	SSD1306_CS_PORT |= ssd1306csMask;
+	
+#elif SSD1306_I2C == 1
+
+	bool open = false;
+	uint8_t i = 0;
+	
+	while(i < ssd1306QueueLength)
+	{
+		bool runIsData = SSD1306QueuedIsData(i);
+		uint8_t end = i;
+		
+		while(end < ssd1306QueueLength && SSD1306QueuedIsData(end) == runIsData)
+		{
+			end++;
+		}
+		
+		//The last run carries on into the bytes passed when they are the same kind
+		bool last = (end == ssd1306QueueLength) && (length == 0 || isData == runIsData);
+		
+		if(!open)
+		{
+			I2CStart((SSD1306_ADDRESS << 1) | 0);
+			open = true;
+		}
+		
+		if(last || end - i > 2)
+		{
+			I2CByte(runIsData ? SSD1306_CMD_SEND_DATA : SSD1306_CMD_SEND_CMD);
+			
+			for(; i < end; i++)
+			{
+				I2CByte(ssd1306Queue[i]);
+			}
+			
+			if(last)
+			{
+				for(uint16_t j = 0; j < length; j++)
+				{
+					I2CByte(bytes[j]);
+				}
+				
+				length = 0;
+			}
+			
+			//Nothing but data can follow a streamed run
+			i2c_stop();
+			open = false;
+		}
+		else
+		{
+			for(; i < end; i++)
+			{
+				I2CByte(runIsData ? SSD1306_CMD_SEND_ONE_DATA : SSD1306_CMD_SEND_ONE_CMD);
+				I2CByte(ssd1306Queue[i]);
+			}
+		}
+	}
+	
+	if(length > 0)
+	{
+		if(!open)
+		{
+			I2CStart((SSD1306_ADDRESS << 1) | 0);
+		}
+		
+		I2CByte(isData ? SSD1306_CMD_SEND_DATA : SSD1306_CMD_SEND_CMD);
+		
+		for(uint16_t j = 0; j < length; j++)
+		{
+			I2CByte(bytes[j]);
+		}
+		
+		i2c_stop();
+	}
+	
+#endif
+
+	ssd1306QueueLength = 0;
+}
+
+
+
+/**
+* \brief Adds bytes to the queue. When they don't fit they go out straight away along with the queue.
+* \param bytes The bytes to add
+* \param length The number of bytes
+* \param isData If the bytes are data
+*/
+static void SSD1306QueueBytes(const uint8_t* bytes, uint16_t length, bool isData)
+{
+	if(length > SSD1306_QUEUE_SIZE - ssd1306QueueLength)
+	{
+		SSD1306QueueTransfer(bytes, length, isData);
+		return;
+	}
+	
+	for(uint16_t i = 0; i < length; i++)
+	{
+		uint8_t at = ssd1306QueueLength++;
+		
+		if(isData)
+		{
+			ssd1306QueueIsData[at >> 3] |= (1 << (at & 7));
+		}
+		else
+		{
+			ssd1306QueueIsData[at >> 3] &= ~(1 << (at & 7));
+		}
+		
+		ssd1306Queue[at] = bytes[i];
+	}
+}
+
+#endif
+
+
+
+/**
+ * Sends any commands and data still waiting in the queue to the display. Does nothing without SSD1306_USE_QUEUE.
+ */
+void SSD1306Flush()
+{
+#if SSD1306_USE_QUEUE == 1
+    SSD1306_WAIT_FOR_BUS();
+    SSD1306QueueTransfer(0, 0, false);
+#endif
+}
+
+
+
+/**
+ * Sends a single command to the display. Chip select must be set before running this
+ * \param cmd
+ */
+void SSD1306SendCommand(uint8_t cmd)
+{
+    SSD1306_WAIT_FOR_BUS();
+    
+#if SSD1306_USE_QUEUE == 1
+    SSD1306QueueBytes(&cmd, 1, false);
+#elif SSD1306_SPI == 1
+    
+	SSD1306_CS_PORT &= ~ssd1306csMask;
+    SSD1306_CLEAR_DC();
+    SpiTransmit(cmd);
+    SSD1306_SET_DC();
+    SSD1306_CS_PORT |= ssd1306csMask;
+	
+#elif SSD1306_I2C == 1
+    I2CStart((SSD1306_ADDRESS << 1) | 0);
+    I2CByte(SSD1306_CMD_SEND_CMD);    // 0x00 for command, 0x40 for data
+    I2CByte(cmd);
+    i2c_stop();
+#endif
+}
+
+
+
+/**
+ * Sends commands to the display. Chip select must be set before running this
+ * \param cmd
+ */
+void SSD1306SendMoreCommands(uint8_t* cmd)
+{
+    SSD1306_WAIT_FOR_BUS();
+    
+#if SSD1306_USE_QUEUE == 1
+    SSD1306QueueBytes(cmd, strlen((char*)cmd), false);
+#elif SSD1306_SPI == 1
+    SSD1306_CS_PORT &= ~ssd1306csMask;
     SSD1306_CLEAR_DC();
     while(*cmd) SpiTransmit(*cmd++);
     SSD1306_SET_DC();
-    SSD1306_CS_PORT |= (1 << ssd1306csPinPositions[currentDisplay]);
+    SSD1306_CS_PORT |= ssd1306csMask;
 #elif SSD1306_I2C == 1
     I2CStart((SSD1306_ADDRESS << 1) | 0);
     I2CByte(SSD1306_CMD_SEND_CMD);    // 0x00 for command, 0x40 for data
@@ -231,15 +887,19 @@ void SSD1306SendMoreCommands(uint8_t* cmd)
  */
 void SSD1306SendCommandArray(uint8_t cmds[], uint16_t cmdlen)
 {
-#if SSD1306_SPI == 1
-    SSD1306_CS_PORT &= ~(1 << ssd1306csPinPositions[currentDisplay]);
+    SSD1306_WAIT_FOR_BUS();
+    
+#if SSD1306_USE_QUEUE == 1
+    SSD1306QueueBytes(cmds, cmdlen, false);
+#elif SSD1306_SPI == 1
+    SSD1306_CS_PORT &= ~ssd1306csMask;
     SSD1306_CLEAR_DC();
     for(uint16_t i = 0; i < cmdlen; i++) {
         SpiTransmit(cmds[i]);
     }
     
     SSD1306_SET_DC();
-    SSD1306_CS_PORT |= (1 << ssd1306csPinPositions[currentDisplay]);
+    SSD1306_CS_PORT |= ssd1306csMask;
     
 #elif SSD1306_I2C == 1
     I2CStart((SSD1306_ADDRESS << 1) | 0);
@@ -261,11 +921,15 @@ void SSD1306SendCommandArray(uint8_t cmds[], uint16_t cmdlen)
  */
 void SSD1306SendData(uint8_t data)
 {
-#if SSD1306_SPI == 1
-    SSD1306_CS_PORT &= ~(1 << ssd1306csPinPositions[currentDisplay]);
+    SSD1306_WAIT_FOR_BUS();
+    
+#if SSD1306_USE_QUEUE == 1
+    SSD1306QueueBytes(&data, 1, true);
+#elif SSD1306_SPI == 1
+    SSD1306_CS_PORT &= ~ssd1306csMask;
     SSD1306_SET_DC();
     SpiTransmit(data);
-    SSD1306_CS_PORT |= (1 << ssd1306csPinPositions[currentDisplay]);
+    SSD1306_CS_PORT |= ssd1306csMask;
 #elif SSD1306_I2C == 1
     I2CStart((SSD1306_ADDRESS << 1) | 0);
     I2CByte(SSD1306_CMD_SEND_DATA);    // 0x00 for command, 0x40 for data
@@ -282,11 +946,15 @@ void SSD1306SendData(uint8_t data)
  */
 void SSD1306SendMoreData(uint8_t* data)
 {
-#if SSD1306_SPI == 1
-    SSD1306_CS_PORT &= ~(1 << ssd1306csPinPositions[currentDisplay]);
+    SSD1306_WAIT_FOR_BUS();
+    
+#if SSD1306_USE_QUEUE == 1
+    SSD1306QueueBytes(data, strlen((char*)data), true);
+#elif SSD1306_SPI == 1
+    SSD1306_CS_PORT &= ~ssd1306csMask;
     SSD1306_SET_DC();
     while(*data) SpiTransmit(*data++);
-    SSD1306_CS_PORT |= (1 << ssd1306csPinPositions[currentDisplay]);
+    SSD1306_CS_PORT |= ssd1306csMask;
 #elif SSD1306_I2C == 1
     I2CStart((SSD1306_ADDRESS << 1) | 0);
     I2CByte(SSD1306_CMD_SEND_DATA);    // 0x00 for command, 0x40 for data
@@ -303,15 +971,19 @@ void SSD1306SendMoreData(uint8_t* data)
  */
 void SSD1306SendDataArray(uint8_t data[], uint16_t datalen)
 {
-    #if SSD1306_SPI == 1
-    SSD1306_CS_PORT &= ~(1 << ssd1306csPinPositions[currentDisplay]);
+    SSD1306_WAIT_FOR_BUS();
+    
+#if SSD1306_USE_QUEUE == 1
+    SSD1306QueueBytes(data, datalen, true);
+#elif SSD1306_SPI == 1
+    SSD1306_CS_PORT &= ~ssd1306csMask;
     SSD1306_SET_DC();
     
     for(uint16_t i = 0; i < datalen; i++) {
         SpiTransmit(data[i]);
     }
     
-    SSD1306_CS_PORT |= (1 << ssd1306csPinPositions[currentDisplay]);
+    SSD1306_CS_PORT |= ssd1306csMask;
     
 #elif SSD1306_I2C == 1
     I2CStart((SSD1306_ADDRESS << 1) | 0);
@@ -335,6 +1007,9 @@ void SSD1306ClearScreen()
 	
 #if !defined(SSD1306_DRAW_IMMEDIATE) || SSD1306_DRAW_IMMEDIATE < 1
     SSD1306ClearBuffer();
+	
+	//The display ram is unknown here, so every byte has to go out, not just the changes
+	SSD1306InvalidateBuffer();
 	SSD1306Update();
 	//for (uint8_t i = 0; i < SSD1306_HEIGHT/8; i++)
 	//{
@@ -444,6 +1119,192 @@ void SSD1306StartScrollLeft(uint8_t start, uint8_t stop)
 
 
 
+/**
+ * \brief Sets the display start line, the row of display ram shown at the top of the screen
+ * 
+ * 
+ * \param line -The row, 0 to 63
+ */
+void SSD1306SetStartLine(uint8_t line)
+{
+	SSD1306SendCommand(SSD1306_SET_START_LINE | (line & 0x3F));
+}
+
+
+
+///Pages of display ram the console cycles through, all of them so a shorter screen still has the rows below it to scroll into
+#define SSD1306_CONSOLE_RAM_PAGES	(MAX_SSD1306_HEIGHT/8)
+
+static const char* ssd1306ConsoleFont = 0;
+static uint8_t ssd1306ConsoleFontLength = 0;
+
+///Display ram page shown at the top of the screen
+static uint8_t ssd1306ConsoleTop = 0;
+
+///Screen line and character column of the console cursor
+static uint8_t ssd1306ConsoleRow = 0;
+static uint8_t ssd1306ConsoleColumn = 0;
+
+
+
+/**
+ * \brief Clears one page of display ram
+ * \param page The display ram page
+ */
+static void SSD1306ConsoleClearPage(uint8_t page)
+{
+	unsigned char blank[SSD1306_WIDTH] = {0};
+	
+	SSD1306SetAddressWindow(0, SSD1306_WIDTH-1, page, page);
+	SSD1306SendDataArray(blank, sizeof(blank));
+}
+
+
+
+/**
+ * \brief Starts the console, which writes text straight to the display and scrolls it with the start line. \n
+ * The console owns the display until SSD1306ConsoleEnd, do not update the buffer onto the display in between.
+ * 
+ * 
+ * \param fontSheet -The font sheet, starting at ' '
+ * \param fontSheetCharacterLength -The number of columns in each glyph
+ */
+void SSD1306ConsoleBegin(const char fontSheet[], uint8_t fontSheetCharacterLength)
+{
+	ssd1306ConsoleFont = fontSheet;
+	ssd1306ConsoleFontLength = fontSheetCharacterLength;
+	ssd1306ConsoleTop = 0;
+	ssd1306ConsoleRow = 0;
+	ssd1306ConsoleColumn = 0;
+	
+	for(uint8_t page = 0; page < SSD1306_CONSOLE_RAM_PAGES; page++)
+	{
+		SSD1306ConsoleClearPage(page);
+	}
+	
+	SSD1306SetStartLine(0);
+}
+
+
+
+/**
+ * \brief Moves the console to the start of the next line. On the last line the screen scrolls up a line,
+ * which costs clearing the one page that comes into view and a start line command.
+ */
+static void SSD1306ConsoleNewLine()
+{
+	ssd1306ConsoleColumn = 0;
+	
+	if(ssd1306ConsoleRow < SSD1306_PAGES-1)
+	{
+		ssd1306ConsoleRow++;
+		return;
+	}
+	
+	ssd1306ConsoleTop = (ssd1306ConsoleTop + 1) % SSD1306_CONSOLE_RAM_PAGES;
+	
+	SSD1306ConsoleClearPage((ssd1306ConsoleTop + ssd1306ConsoleRow) % SSD1306_CONSOLE_RAM_PAGES);
+	SSD1306SetStartLine(ssd1306ConsoleTop*8);
+}
+
+
+
+/**
+ * \brief Writes a char to the console. \\n starts a new line, \\r returns to the start of the line
+ * and \\b blanks the previous char. Lines wrap when they reach the edge of the screen.
+ * 
+ * 
+ * \param c -The char
+ */
+void SSD1306ConsolePutChar(char c)
+{
+	if(ssd1306ConsoleFont == 0)
+	{
+		return;
+	}
+	
+	uint8_t length = ssd1306ConsoleFontLength;
+	uint8_t page = (ssd1306ConsoleTop + ssd1306ConsoleRow) % SSD1306_CONSOLE_RAM_PAGES;
+	
+	switch(c)
+	{
+		case '\n':
+			SSD1306ConsoleNewLine();
+			return;
+		
+		case '\r':
+			ssd1306ConsoleColumn = 0;
+			return;
+		
+		case '\b':
+			if(ssd1306ConsoleColumn > 0)
+			{
+				unsigned char blank[length];
+				
+				memset(blank, 0x00, length);
+				ssd1306ConsoleColumn--;
+				SSD1306SetAddressWindow(ssd1306ConsoleColumn*length, ssd1306ConsoleColumn*length + length-1, page, page);
+				SSD1306SendDataArray(blank, length);
+			}
+			return;
+		
+		default:
+			break;
+	}
+	
+	if((uint8_t)c < ' ')
+	{
+		return;
+	}
+	
+	if((ssd1306ConsoleColumn+1)*length > SSD1306_WIDTH)
+	{
+		SSD1306ConsoleNewLine();
+		page = (ssd1306ConsoleTop + ssd1306ConsoleRow) % SSD1306_CONSOLE_RAM_PAGES;
+	}
+	
+	SSD1306SetAddressWindow(ssd1306ConsoleColumn*length, ssd1306ConsoleColumn*length + length-1, page, page);
+	SSD1306SendDataArray((uint8_t*)&ssd1306ConsoleFont[(uint16_t)((uint8_t)c - ' ') * length], length);
+	
+	ssd1306ConsoleColumn++;
+}
+
+
+
+/**
+ * \brief Writes a string to the console
+ * 
+ * 
+ * \param s -The string
+ */
+void SSD1306ConsolePutString(const char* s)
+{
+	while(*s)
+	{
+		SSD1306ConsolePutChar(*s++);
+	}
+}
+
+
+
+/**
+ * \brief Stops the console and puts the start line back. The display ram no longer matches the buffer,
+ * so the whole buffer goes out on the next update.
+ */
+void SSD1306ConsoleEnd()
+{
+	ssd1306ConsoleFont = 0;
+	
+	SSD1306SetStartLine(0);
+	SSD1306Flush();
+	
+#if !defined(SSD1306_DRAW_IMMEDIATE) || SSD1306_DRAW_IMMEDIATE < 1
+	SSD1306InvalidateBuffer();
+#endif
+}
+
+
+
 /**
  * Goes the the position on the display
  * \param x The x position on the OLED screen
@@ -493,7 +1354,7 @@ void SSD1306GoToPixelPosition(uint8_t x, uint8_t y)
 	//}
 	//
 	
-	if( x > (SSD1306_WIDTH) || y > (SSD1306_HEIGHT/8-1))
+	if( x > (SSD1306_WIDTH) || y > (SSD1306_PAGES-1))
 	{
 		return;// out of display
 	}
@@ -501,9 +1362,12 @@ void SSD1306GoToPixelPosition(uint8_t x, uint8_t y)
 	cursorPosY=y;
 	cursorPosX=x;
 	
-	uint8_t commandSequence[4] = {0xb0+y, 0x21, x, 0x7f};
+#if SSD1306_STRIP_MODE != 1
+	//Set the page for page addressing mode as well as the column and page ranges for horizontal addressing mode
+	uint8_t commandSequence[7] = {SSD1306_SET_PAGE_ADDR+y, SSD1306_SET_COLUMN_ADDR, x, SSD1306_WIDTH-1, SSD1306_SET_PAGE_RANGE, y, SSD1306_PAGES-1};
 	
 	SSD1306SendCommandArray(commandSequence, sizeof(commandSequence));
+#endif
 }
 
 
@@ -516,13 +1380,13 @@ void SSD1306GoToPixelPosition(uint8_t x, uint8_t y)
  */
 void SSD1306PutChar(char c) 
 {
-
+    SSD1306_RECORD_WRITE(SSD1306_OP_PUT_CHAR, cursorPosX, cursorPosY, c);
     
 #if defined(SSD1306_DRAW_IMMEDIATE) && SSD1306_DRAW_IMMEDIATE > 0
                 
         SSD1306SendData(c);
 #else
-        SSD1306DisplayBuffer[cursorPosY][cursorPosX] = c;
+        SSD1306WriteToBuffer(c, cursorPosX, cursorPosY);
                 
 #endif
 
@@ -563,642 +1427,2597 @@ void SSD1306PutP(PGM_P progmemS) {
 #endif
 
 
- /**
-  * \brief Writes a char onto the screen
-  * 
-  * 
-  * \param c -The char
-  */
- void SSD1306PutFontChar(char c, const char fontSheet[], uint8_t fontSheetCharacterLength) 
- {
-
- 	switch (c)
+/**
+ * \brief Reads a byte of a font sheet
+ * \param fontSheet The font sheet, in RAM or progmem
+ * \param i The index of the byte
+ * \param fromProgmem If the font sheet is in progmem
+ */
+static inline uint8_t SSD1306FontByte(const char* fontSheet, uint16_t i, bool fromProgmem)
+{
+#if defined(__AVR)
+	if(fromProgmem)
 	{
-		//Backspace
-		case '\b':
+		return pgm_read_byte(&fontSheet[i]);
+	}
+#else
+	(void)fromProgmem;
+#endif
+	return (uint8_t)fontSheet[i];
+}
+
+
+
+/**
+ * \brief Copies the columns of a glyph straight into the buffer, or the display when drawing immediately
+ * 
+ * A page aligned y is a straight copy, otherwise each column is shifted and merged into the two pages it covers.
+ * The glyph overwrites the 8 rows it covers and nothing else. No bounds checks on x or the top page.
+ * 
+ * \param glyph The glyph's columns, or 0 for a blank glyph
+ * \param width The number of columns in the glyph
+ * \param x The x position of the glyph
+ * \param y The y position of the top row of the glyph
+ * \param fromProgmem If the glyph is in progmem
+ * \return true if any byte of the buffer changed
+ */
+static bool SSD1306BlitGlyph(const char* glyph, uint8_t width, uint8_t x, uint8_t y, bool fromProgmem)
+{
+	uint8_t page = y >> 3;
+	uint8_t shift = y & 7;
+	
+#if defined(SSD1306_DRAW_IMMEDIATE) && SSD1306_DRAW_IMMEDIATE > 0
+
+	//The display can't be read back, so only whole pages can be written
+	if(shift != 0)
+	{
+		return false;
+	}
+	
+	SSD1306GoToPixelPosition(x, page);
+	
+	if(glyph != 0 && !fromProgmem)
+	{
+		SSD1306SendDataArray((uint8_t*)glyph, width);
+	}
+	else
+	{
+		for(uint8_t j = 0; j < width; j++)
+		{
+			SSD1306SendData((glyph != 0) ? SSD1306FontByte(glyph, j, fromProgmem) : 0x00);
+		}
+	}
+	
+	return true;
+	
+#else
+
+	uint8_t* top = SSD1306BufferRow(page);
+	bool changed = false;
+	
+	if(shift == 0)
+	{
+		if(top == 0)
+		{
+			return false;
+		}
+		
+		top += x;
+		
+		if(glyph == 0)
+		{
+			for(uint8_t j = 0; j < width && !changed; j++)
+			{
+				changed = (top[j] != 0x00);
+			}
+			memset(top, 0x00, width);
+		}
+#if defined(__AVR)
+		else if(fromProgmem)
+		{
+			changed = (memcmp_P(top, glyph, width) != 0);
+			memcpy_P(top, glyph, width);
+		}
+#endif
+		else
+		{
+			changed = (memcmp(top, glyph, width) != 0);
+			memcpy(top, glyph, width);
+		}
+		
+		return changed;
+	}
+	
+	uint8_t* bottom = (page + 1 < SSD1306_PAGES) ? SSD1306BufferRow(page + 1) : 0;
+	
+	//Rows of each page the glyph doesn't cover
+	uint8_t keepTop = 0xFF >> (8 - shift);
+	uint8_t keepBottom = 0xFF << shift;
+	
+	for(uint8_t j = 0; j < width; j++, x++)
+	{
+		uint8_t column = (glyph != 0) ? SSD1306FontByte(glyph, j, fromProgmem) : 0x00;
+		
+		if(top != 0)
+		{
+			uint8_t data = (top[x] & keepTop) | (uint8_t)(column << shift);
+			changed |= (data != top[x]);
+			top[x] = data;
+		}
+		
+		if(bottom != 0)
+		{
+			uint8_t data = (bottom[x] & keepBottom) | (uint8_t)(column >> (8 - shift));
+			changed |= (data != bottom[x]);
+			bottom[x] = data;
+		}
+	}
+	
+	return changed;
+	
+#endif
+}
+
+
+
+/**
+ * \brief Marks the columns of a line of glyphs dirty in the pages it covers
+ * \param y The y position of the top row of the line
+ * \param startX The first column that changed
+ * \param endX One past the last column that changed
+ */
+static inline void SSD1306MarkLineDirty(uint8_t y, uint8_t startX, uint8_t endX)
+{
+#if !defined(SSD1306_DRAW_IMMEDIATE) || SSD1306_DRAW_IMMEDIATE < 1
+	if(startX >= endX)
+	{
+		return;
+	}
+	
+	SSD1306MarkDirty(y >> 3, startX, endX);
+	
+	if((y & 7) != 0 && (y >> 3) + 1 < SSD1306_PAGES)
+	{
+		SSD1306MarkDirty((y >> 3) + 1, startX, endX);
+	}
+#else
+	(void)y;
+	(void)startX;
+	(void)endX;
+#endif
+}
+
+
+
+/**
+ * \brief Blits a string from a font sheet in one pass, marking the dirty spans once per line
+ * 
+ * Handles \\b, \\t, \\n and \\r, other control characters are skipped. Glyphs that don't fit are skipped.
+ * 
+ * \param s The string
+ * \param fontSheet The font sheet, starting at ' '
+ * \param fontSheetCharacterLength The number of columns in each glyph
+ * \param x The x position to start at, left after the last glyph
+ * \param y The y position to start at, left on the last line
+ * \param fromProgmem If the font sheet is in progmem
+ * \return 1 if a glyph didn't fit, 0 if worked
+ */
+static uint8_t SSD1306BlitString(const char* s, const char* fontSheet, uint8_t fontSheetCharacterLength, uint8_t* x, uint8_t* y, bool fromProgmem)
+{
+	uint8_t posX = *x;
+	uint8_t posY = *y;
+	uint8_t lineStart = SSD1306_WIDTH;
+	uint8_t lineEnd = 0;
+	uint8_t clipped = 0;
+	uint8_t tabStop = (SSD1306_WIDTH / fontSheetCharacterLength) * fontSheetCharacterLength;
+	char c;
+	
+	while((c = *s++))
+	{
+		const char* glyph = 0;
+		
+		switch(c)
+		{
+			//Backspace, blanks the previous glyph
+			case '\b':
+				if(posX < fontSheetCharacterLength)
+				{
+					continue;
+				}
+				posX -= fontSheetCharacterLength;
+				break;
+			
+			//Tab
+			case '\t':
+				posX = min(posX + 4*fontSheetCharacterLength, tabStop);
+				continue;
+			
+			//Next line
+			case '\n':
+				if(posY + 16 > SSD1306_PAGES*8)
+				{
+					continue;
+				}
+				break;
+			
+			//Carriage return
+			case '\r':
+				posX = 0;
+				continue;
+			
+			default:
+				if((uint8_t)c < ' ')
+				{
+					continue;
+				}
+				glyph = &fontSheet[(uint16_t)((uint8_t)c - ' ') * fontSheetCharacterLength];
+				break;
+		}
+		
+		if(c == '\n')
+		{
+			//Finish the line before moving down
+			SSD1306MarkLineDirty(posY, lineStart, lineEnd);
+			lineStart = SSD1306_WIDTH;
+			lineEnd = 0;
+			posY += 8;
+			continue;
+		}
+		
+		if(posX + fontSheetCharacterLength > SSD1306_WIDTH)
+		{
+			clipped = 1;
+			continue;
+		}
+		
+		if(SSD1306BlitGlyph(glyph, fontSheetCharacterLength, posX, posY, fromProgmem))
+		{
+			lineStart = min(lineStart, posX);
+			lineEnd = max(lineEnd, posX + fontSheetCharacterLength);
+		}
+#if defined(SSD1306_DRAW_IMMEDIATE) && SSD1306_DRAW_IMMEDIATE > 0
+		else
+		{
+			clipped = 1;
+		}
+#endif
+		
+		//A backspace stays on the glyph it blanked
+		if(glyph != 0)
+		{
+			posX += fontSheetCharacterLength;
+		}
+	}
+	
+	SSD1306MarkLineDirty(posY, lineStart, lineEnd);
+	
+	*x = posX;
+	*y = posY;
+	
+	return clipped;
+}
+
+
+
+/**
+ * \brief Draws a string from a font sheet at any pixel position, without moving the cursor
+ * 
+ * 
+ * \param x The x position of the first glyph
+ * \param y The y position of the top row of the glyphs, must be a multiple of 8 when drawing immediately
+ * \param s The string
+ * \param fontSheet The font sheet, starting at ' '
+ * \param fontSheetCharacterLength The number of columns in each glyph
+ * \return uint8_t 1 if any of the string was out of display, 0 if worked
+ */
+uint8_t SSD1306DrawFontString(uint8_t x, uint8_t y, const char* s, const char fontSheet[], uint8_t fontSheetCharacterLength)
+{
+#if SSD1306_STRIP_MODE == 1
+	if(!ssd1306Replaying)
+	{
+		uint8_t args[4 + SSD1306_OP_POINTER] = {x, y, fontSheetCharacterLength, false};
+		memcpy(&args[4], &fontSheet, SSD1306_OP_POINTER);
+		SSD1306ListAdd(SSD1306_OP_FONT_DRAW, args, s);
+		return 0;
+	}
+#endif
+
+	if(x >= SSD1306_WIDTH || y >= SSD1306_PAGES*8)
+	{
+		return 1;
+	}
+	
+	return SSD1306BlitString(s, fontSheet, fontSheetCharacterLength, &x, &y, false);
+}
+
+
+#if defined(__AVR)
+/**
+ * \brief Draws a string from a progmem font sheet at any pixel position, without moving the cursor
+ * 
+ * 
+ * \param x The x position of the first glyph
+ * \param y The y position of the top row of the glyphs, must be a multiple of 8 when drawing immediately
+ * \param s The string
+ * \param fontSheet The progmem font sheet, starting at ' '
+ * \param fontSheetCharacterLength The number of columns in each glyph
+ * \return uint8_t 1 if any of the string was out of display, 0 if worked
+ */
+uint8_t SSD1306DrawFontStringP(uint8_t x, uint8_t y, const char* s, PGM_P fontSheet, uint8_t fontSheetCharacterLength)
+{
+#if SSD1306_STRIP_MODE == 1
+	if(!ssd1306Replaying)
+	{
+		uint8_t args[4 + SSD1306_OP_POINTER] = {x, y, fontSheetCharacterLength, true};
+		memcpy(&args[4], &fontSheet, SSD1306_OP_POINTER);
+		SSD1306ListAdd(SSD1306_OP_FONT_DRAW, args, s);
+		return 0;
+	}
+#endif
+
+	if(x >= SSD1306_WIDTH || y >= SSD1306_PAGES*8)
+	{
+		return 1;
+	}
+	
+	return SSD1306BlitString(s, fontSheet, fontSheetCharacterLength, &x, &y, true);
+}
+#endif
+
+
+
+/**
+ * \brief Draws a string in a packed font from "font.h" at any pixel position, without moving the cursor
+ * 
+ * Glyphs are read straight from flash, a glyph of several pages is blitted a page at a time and each page overwrites the 8 rows it covers.
+ * \n moves down one line of the font and back to x, \r moves back to x. Characters the font does not have are skipped.
+ * 
+ * \param x The x position of the first glyph
+ * \param y The y position of the top row of the glyphs, must be a multiple of 8 when drawing immediately
+ * \param s The string
+ * \param font The packed font
+ * \return uint8_t 1 if any of the string was out of display, 0 if worked
+ */
+uint8_t SSD1306DrawPackedString(uint8_t x, uint8_t y, const char* s, const uint8_t* font)
+{
+#if SSD1306_STRIP_MODE == 1
+	if(!ssd1306Replaying)
+	{
+		uint8_t args[2 + SSD1306_OP_POINTER] = {x, y};
+		memcpy(&args[2], &font, SSD1306_OP_POINTER);
+		SSD1306ListAdd(SSD1306_OP_PACKED_STRING, args, s);
+		return 0;
+	}
+#endif
+
+	if(x >= SSD1306_WIDTH || y >= SSD1306_PAGES*8)
+	{
+		return 1;
+	}
+	
+#if defined(__AVR)
+	const bool fromProgmem = true;
+#else
+	const bool fromProgmem = false;
+#endif
+	
+	uint8_t spacing = FontPackedSpacing(font);
+	uint8_t linePages = (FontPackedHeight(font) + 7) / 8;
+	uint8_t posX = x;
+	uint8_t lineStart = SSD1306_WIDTH;
+	uint8_t lineEnd = 0;
+	uint8_t clipped = 0;
+	FontGlyph glyph;
+	char c;
+	
+	while(true)
+	{
+		c = *s++;
+		
+		if(c == '\0' || c == '\n' || c == '\r')
+		{
+			//Finish the line, each page of it is its own band of rows
+			for(uint8_t page = 0; page < linePages && y + page*8 < SSD1306_PAGES*8; page++)
+			{
+				SSD1306MarkLineDirty(y + page*8, lineStart, lineEnd);
+			}
+			
+			if(c == '\0')
+			{
+				break;
+			}
+			
+			lineStart = SSD1306_WIDTH;
+			lineEnd = 0;
+			posX = x;
+			
+			if(c == '\n')
+			{
+				if(y + linePages*8 >= SSD1306_PAGES*8)
+				{
+					clipped = 1;
+					break;
+				}
+				
+				y += linePages*8;
+			}
+			continue;
+		}
+		
+		if(!FontPackedGetGlyph(font, c, &glyph))
+		{
+			continue;
+		}
+		
+		if(posX + glyph.width > SSD1306_WIDTH)
+		{
+			clipped = 1;
+			continue;
+		}
+		
+		uint8_t gap = min(spacing, SSD1306_WIDTH - posX - glyph.width);
+		bool changed = false;
+		
+		for(uint8_t page = 0; page < glyph.pages; page++)
+		{
+			if(y + page*8 >= SSD1306_PAGES*8)
+			{
+				clipped = 1;
+				break;
+			}
+			
+			changed |= SSD1306BlitGlyph((const char*)&glyph.columns[page * glyph.width], glyph.width, posX, y + page*8, fromProgmem);
+			
+			if(gap != 0)
+			{
+				changed |= SSD1306BlitGlyph(0, gap, posX + glyph.width, y + page*8, false);
+			}
+		}
+		
+		if(changed)
+		{
+			lineStart = min(lineStart, posX);
+			lineEnd = max(lineEnd, posX + glyph.width + gap);
+		}
+#if defined(SSD1306_DRAW_IMMEDIATE) && SSD1306_DRAW_IMMEDIATE > 0
+		else
+		{
+			clipped = 1;
+		}
+#endif
+		
+		posX += glyph.width + gap;
+	}
+	
+	return clipped;
+}
+
+
+/**
+ * \brief Blits a string from a font sheet with every pixel scaled up, glyphs that don't fit are skipped
+ * 
+ * Each glyph column is scaled with FontScaleColumn and written straight to the buffer a page at a time, up to 8 columns per blit.
+ * \n moves down one scaled line and back to x, \r moves back to x, other control characters are skipped.
+ * 
+ * \param s The string
+ * \param fontSheet The font sheet, starting at ' '
+ * \param fontSheetCharacterLength The number of columns in each glyph
+ * \param scale The factor, 1 to FONT_SCALE_MAX
+ * \param x The x position of the first glyph
+ * \param y The y position of the top row of the glyphs
+ * \param fromProgmem If the font sheet is in progmem
+ * \return 1 if a glyph didn't fit, 0 if worked
+ */
+static uint8_t SSD1306BlitScaledString(const char* s, const char* fontSheet, uint8_t fontSheetCharacterLength, uint8_t scale, uint8_t x, uint8_t y, bool fromProgmem)
+{
+	uint8_t columns[8 * FONT_SCALE_MAX];
+	uint32_t scaled[8];
+	uint8_t glyphWidth = fontSheetCharacterLength * scale;
+	uint8_t posX = x;
+	uint8_t lineStart = SSD1306_WIDTH;
+	uint8_t lineEnd = 0;
+	uint8_t clipped = 0;
+	char c;
+	
+	while((c = *s++))
+	{
+		if(c == '\n' || c == '\r')
+		{
+			for(uint8_t page = 0; page < scale && y + page*8 < SSD1306_PAGES*8; page++)
+			{
+				SSD1306MarkLineDirty(y + page*8, lineStart, lineEnd);
+			}
+			
+			lineStart = SSD1306_WIDTH;
+			lineEnd = 0;
+			posX = x;
+			
+			if(c == '\n')
+			{
+				if(y + 16*scale > SSD1306_PAGES*8)
+				{
+					return 1;
+				}
+				y += 8*scale;
+			}
+			continue;
+		}
+		
+		if((uint8_t)c < ' ')
+		{
+			continue;
+		}
+		
+		if(posX + glyphWidth > SSD1306_WIDTH)
+		{
+			clipped = 1;
+			continue;
+		}
+		
+		uint16_t glyph = (uint16_t)((uint8_t)c - ' ') * fontSheetCharacterLength;
+		bool changed = false;
+		
+		for(uint8_t first = 0; first < fontSheetCharacterLength; first += 8)
+		{
+			uint8_t count = min(fontSheetCharacterLength - first, 8);
+			
+			for(uint8_t j = 0; j < count; j++)
+			{
+				scaled[j] = FontScaleColumn(SSD1306FontByte(fontSheet, glyph + first + j, fromProgmem), scale);
+			}
+			
+			for(uint8_t page = 0; page < scale && y + page*8 < SSD1306_PAGES*8; page++)
+			{
+				uint8_t* column = columns;
+				
+				for(uint8_t j = 0; j < count; j++)
+				{
+					uint8_t data = (uint8_t)(scaled[j] >> (page * 8));
+					
+					for(uint8_t k = 0; k < scale; k++)
+					{
+						*column++ = data;
+					}
+				}
+				
+				changed |= SSD1306BlitGlyph((const char*)columns, count * scale, posX + first * scale, y + page*8, false);
+			}
+		}
+		
+		if(changed)
+		{
+			lineStart = min(lineStart, posX);
+			lineEnd = max(lineEnd, posX + glyphWidth);
+		}
+#if defined(SSD1306_DRAW_IMMEDIATE) && SSD1306_DRAW_IMMEDIATE > 0
+		else
+		{
+			clipped = 1;
+		}
+#endif
+		
+		posX += glyphWidth;
+	}
+	
+	for(uint8_t page = 0; page < scale && y + page*8 < SSD1306_PAGES*8; page++)
+	{
+		SSD1306MarkLineDirty(y + page*8, lineStart, lineEnd);
+	}
+	
+	return clipped;
+}
+
+
+
+/**
+ * \brief Draws a string from a font sheet scaled up 1 to FONT_SCALE_MAX times at any pixel position, without moving the cursor
+ * 
+ * 
+ * \param x The x position of the first glyph
+ * \param y The y position of the top row of the glyphs, must be a multiple of 8 when drawing immediately
+ * \param s The string
+ * \param fontSheet The font sheet, starting at ' '
+ * \param fontSheetCharacterLength The number of columns in each glyph
+ * \param scale The factor, ex. SSD1306_DOUBLESIZE
+ * \return uint8_t 1 if any of the string was out of display, 0 if worked
+ */
+uint8_t SSD1306DrawScaledString(uint8_t x, uint8_t y, const char* s, const char fontSheet[], uint8_t fontSheetCharacterLength, uint8_t scale)
+{
+#if SSD1306_STRIP_MODE == 1
+	if(!ssd1306Replaying)
+	{
+		uint8_t args[5 + SSD1306_OP_POINTER] = {x, y, fontSheetCharacterLength, scale, false};
+		memcpy(&args[5], &fontSheet, SSD1306_OP_POINTER);
+		SSD1306ListAdd(SSD1306_OP_SCALED_STRING, args, s);
+		return 0;
+	}
+#endif
+
+	if(x >= SSD1306_WIDTH || y >= SSD1306_PAGES*8 || scale < 1 || scale > FONT_SCALE_MAX)
+	{
+		return 1;
+	}
+	
+	return SSD1306BlitScaledString(s, fontSheet, fontSheetCharacterLength, scale, x, y, false);
+}
+
+
+#if defined(__AVR)
+/**
+ * \brief Draws a string from a progmem font sheet scaled up 1 to FONT_SCALE_MAX times at any pixel position, without moving the cursor
+ * 
+ * 
+ * \param x The x position of the first glyph
+ * \param y The y position of the top row of the glyphs, must be a multiple of 8 when drawing immediately
+ * \param s The string
+ * \param fontSheet The progmem font sheet, starting at ' '
+ * \param fontSheetCharacterLength The number of columns in each glyph
+ * \param scale The factor, ex. SSD1306_DOUBLESIZE
+ * \return uint8_t 1 if any of the string was out of display, 0 if worked
+ */
+uint8_t SSD1306DrawScaledStringP(uint8_t x, uint8_t y, const char* s, PGM_P fontSheet, uint8_t fontSheetCharacterLength, uint8_t scale)
+{
+#if SSD1306_STRIP_MODE == 1
+	if(!ssd1306Replaying)
+	{
+		uint8_t args[5 + SSD1306_OP_POINTER] = {x, y, fontSheetCharacterLength, scale, true};
+		memcpy(&args[5], &fontSheet, SSD1306_OP_POINTER);
+		SSD1306ListAdd(SSD1306_OP_SCALED_STRING, args, s);
+		return 0;
+	}
+#endif
+
+	if(x >= SSD1306_WIDTH || y >= SSD1306_PAGES*8 || scale < 1 || scale > FONT_SCALE_MAX)
+	{
+		return 1;
+	}
+	
+	return SSD1306BlitScaledString(s, fontSheet, fontSheetCharacterLength, scale, x, y, true);
+}
+#endif
+
+
+
+#if SSD1306_STRIP_MODE != 1
+
+///Glyph of a big number digit showing a minus sign
+#define SSD1306_BIG_MINUS			10
+
+///Glyph of a big number digit left blank
+#define SSD1306_BIG_BLANK			11
+
+///Glyph of a big number digit not drawn yet
+#define SSD1306_BIG_NONE			0xFF
+
+///Columns from one big number digit to the next
+#define SSD1306_BIG_PITCH			(FONT_BIG_NUM_WIDTH + SSD1306_BIG_NUMBER_GAP)
+
+
+
+/**
+ * \brief Turns the rows of a big number glyph into page columns and blits them, one band of 8 rows at a time
+ * \param glyphs The glyph table
+ * \param glyph The glyph, or SSD1306_BIG_BLANK
+ * \param x The x position of the digit
+ * \param y The y position of the top row of the digit
+ */
+static void SSD1306BigNumberDrawDigit(const uint8_t* glyphs, uint8_t glyph, uint8_t x, uint8_t y)
+{
+	uint8_t columns[FONT_BIG_NUM_WIDTH];
+	const uint8_t* rows = &glyphs[(uint16_t)glyph * FONT_BIG_NUM_HEIGHT * (FONT_BIG_NUM_WIDTH/8)];
+	
+	for(uint8_t band = 0; band < (FONT_BIG_NUM_HEIGHT + 7) / 8 && y + band*8 < SSD1306_PAGES*8; band++)
+	{
+		memset(columns, 0x00, sizeof(columns));
+		
+		for(uint8_t bit = 0; glyph != SSD1306_BIG_BLANK && bit < 8 && band*8 + bit < FONT_BIG_NUM_HEIGHT; bit++)
+		{
+			const uint8_t* row = &rows[(band*8 + bit) * (FONT_BIG_NUM_WIDTH/8)];
+			uint8_t* column = columns;
+			
+			for(uint8_t i = 0; i < FONT_BIG_NUM_WIDTH/8; i++)
+			{
+				uint8_t pixels = row[i];
+				
+				//Leftmost pixel in the top bit
+				for(uint8_t j = 0; j < 8; j++, pixels <<= 1)
+				{
+					if(pixels & 0x80)
+					{
+						*column |= 1 << bit;
+					}
+					column++;
+				}
+			}
+		}
+		
+		if(SSD1306BlitGlyph((const char*)columns, FONT_BIG_NUM_WIDTH, x, y + band*8, false))
+		{
+			SSD1306MarkLineDirty(y + band*8, x, x + FONT_BIG_NUM_WIDTH);
+		}
+	}
+}
+
+
+
+/**
+ * \brief Sets up a big number readout, nothing is drawn until the first SSD1306BigNumberSet
+ * 
+ * Each digit covers FONT_BIG_NUM_WIDTH columns and the 24 rows of its three bands, digits are SSD1306_BIG_NUMBER_GAP columns apart.
+ * The gap columns are never drawn.
+ * 
+ * \param field The readout
+ * \param x The x position of the first digit
+ * \param y The y position of the top row of the digits, must be a multiple of 8 when drawing immediately
+ * \param digits The number of digits including a minus sign, cut down to SSD1306_BIG_NUMBER_MAX_DIGITS and to what fits
+ * \param glyphs The 11 glyphs, digits 0 to 9 then a minus sign, ex. BIG_NUMBERS[0]
+ */
+void SSD1306BigNumberInit(SSD1306BigNumber* field, uint8_t x, uint8_t y, uint8_t digits, const uint8_t* glyphs)
+{
+	uint8_t fit = (x + FONT_BIG_NUM_WIDTH <= SSD1306_WIDTH) ? (SSD1306_WIDTH - x - FONT_BIG_NUM_WIDTH) / SSD1306_BIG_PITCH + 1 : 0;
+	
+	field->glyphs = glyphs;
+	field->x = x;
+	field->y = y;
+	field->digits = min(min(digits, SSD1306_BIG_NUMBER_MAX_DIGITS), fit);
+	
+	SSD1306BigNumberInvalidate(field);
+}
+
+
+
+/**
+ * \brief Forgets what a big number readout drew so the next SSD1306BigNumberSet draws every digit, ex. after clearing the buffer
+ * \param field The readout
+ */
+void SSD1306BigNumberInvalidate(SSD1306BigNumber* field)
+{
+	memset(field->shown, SSD1306_BIG_NONE, sizeof(field->shown));
+}
+
+
+
+/**
+ * \brief Shows a value right aligned in a big number readout, only the digits that differ from the last value are drawn
+ * 
+ * A value that does not fit shows a minus sign in every digit.
+ * 
+ * \param field The readout
+ * \param value The value
+ * \return uint8_t The number of digits drawn
+ */
+uint8_t SSD1306BigNumberSet(SSD1306BigNumber* field, int32_t value)
+{
+	uint8_t glyphs[SSD1306_BIG_NUMBER_MAX_DIGITS];
+	uint32_t magnitude = (value < 0) ? -(uint32_t)value : (uint32_t)value;
+	uint8_t i = field->digits;
+	uint8_t drawn = 0;
+	
+	if(i == 0)
+	{
+		return 0;
+	}
+	
+	do
+	{
+		glyphs[--i] = magnitude % 10;
+		magnitude /= 10;
+	} while(magnitude != 0 && i != 0);
+	
+	bool overflow = (magnitude != 0);
+	
+	if(value < 0)
+	{
+		if(i == 0)
+		{
+			overflow = true;
+		}
+		else
+		{
+			glyphs[--i] = SSD1306_BIG_MINUS;
+		}
+	}
+	
+	while(i != 0)
+	{
+		glyphs[--i] = SSD1306_BIG_BLANK;
+	}
+	
+	if(overflow)
+	{
+		memset(glyphs, SSD1306_BIG_MINUS, field->digits);
+	}
+	
+	for(i = 0; i < field->digits; i++)
+	{
+		if(glyphs[i] == field->shown[i])
+		{
+			continue;
+		}
+		
+		SSD1306BigNumberDrawDigit(field->glyphs, glyphs[i], field->x + i*SSD1306_BIG_PITCH, field->y);
+		field->shown[i] = glyphs[i];
+		drawn++;
+	}
+	
+	return drawn;
+}
+
+#endif
+
+
+
+ /**
+  * \brief Writes a char onto the screen
+  * 
+  * 
+  * \param c -The char
+  */
+ void SSD1306PutFontChar(char c, const char fontSheet[], uint8_t fontSheetCharacterLength) 
+ {
+#if SSD1306_STRIP_MODE == 1
+	if(!ssd1306Replaying)
+	{
+		uint8_t args[4 + SSD1306_OP_POINTER] = {cursorPosX, cursorPosY, c, fontSheetCharacterLength};
+		memcpy(&args[4], &fontSheet, SSD1306_OP_POINTER);
+		SSD1306ListAdd(SSD1306_OP_FONT_CHAR, args, 0);
+		
+		//Run it with nothing to draw into so the cursor still moves
+		ssd1306Replaying = true;
+		SSD1306PutFontChar(c, fontSheet, fontSheetCharacterLength);
+		ssd1306Replaying = false;
+		return;
+	}
+#endif
+
+ 	switch (c)
+	{
+		//Backspace
+		case '\b':
+			
+			SSD1306GoToPosition(cursorPosX-1, cursorPosY,fontSheetCharacterLength);
+			SSD1306PutFontChar(' ', fontSheet, fontSheetCharacterLength);		
+			SSD1306GoToPosition(cursorPosX-1, cursorPosY,fontSheetCharacterLength);
+		break;
+		
+		//Tab
+		case '\t':
+			if( (cursorPosX+4) < (SSD1306_WIDTH / fontSheetCharacterLength)-4 )
+			{
+				SSD1306GoToPosition(cursorPosX+4, cursorPosY,fontSheetCharacterLength);
+			}
+			else
+			{
+				SSD1306GoToPosition(SSD1306_WIDTH / fontSheetCharacterLength, cursorPosY,fontSheetCharacterLength);
+			}
+
+		break;
+		
+		//Next line
+		case '\n':
+			if(cursorPosY < (SSD1306_PAGES-1))
+			{
+				SSD1306GoToPosition(cursorPosX, cursorPosY+1,fontSheetCharacterLength);
+			}
+
+		break;
+		
+		//Carriage return
+		case '\r':
+			SSD1306GoToPosition(0, cursorPosY, fontSheetCharacterLength);
+
+		break;
+		
+		////Clear screen
+		//case '\f':
+			//SSD1306ClearScreen();
+		//break;
+
+		default:
+			
+			//If c does not fit or is not good
+			if(cursorPosX >= SSD1306_WIDTH-fontSheetCharacterLength)
+			{
+				//break
+				break;
+			}
+			
+			//else...
+			for (uint8_t j = 0; j < fontSheetCharacterLength; j++)
+			{
+				////Check for error
+				//if(cursorPosX+fontSheetCharacterLength > SSD1306_WIDTH)
+				//{
+					//break;
+				//}
+				
+				SSD1306PutChar(fontSheet[j]);
+				cursorPosX+=1;
+				//#if defined(SSD1306_DRAW_IMMEDIATE) && SSD1306_DRAW_IMMEDIATE > 0
+					//SSD1306GoToPixelPosition(cursorPosX+j, cursorPosY);
+					//SSD1306SendData(fontSheet[((c - ' ') * fontSheetCharacterLength)+j]);
+				//#else
+					////SSD1306DisplayBuffer[cursorPosY][cursorPosX+j] = fontSheet[((c - ' ') * fontSheetCharacterLength)+j];
+					//SSD1306DisplayBuffer[cursorPosY][cursorPosX] = fontSheet[j];
+				//#endif			
+				
+			}
+			
+			//cursorPosX+=fontSheetCharacterLength;
+			
+			//if(cursorPosX >= SSD1306_WIDTH)
+			//{
+				//cursorPosX = 0;
+				//cursorPosY += fontSheetCharacterLength;
+			//}
+			//
+			//if(cursorPosY >= SSD1306_HEIGHT)
+			//{
+				//return;
+			//}
+			
+				
+			
+			
+		break;
+	}
+ }
+
+
+
+ /**
+  * \brief Writes a string onto the screen
+  * 
+  * 
+  * \param s 
+  */
+ void SSD1306PutFontString(
+ char* s,
+ uint8_t fontSheetCharacterLength,
+ char fontSheet[]
+ )
+ {
+#if SSD1306_STRIP_MODE == 1
+	if(!ssd1306Replaying)
+	{
+		uint8_t args[3 + SSD1306_OP_POINTER] = {cursorPosX, cursorPosY, fontSheetCharacterLength};
+		memcpy(&args[3], &fontSheet, SSD1306_OP_POINTER);
+		SSD1306ListAdd(SSD1306_OP_FONT_STRING, args, s);
+		
+		ssd1306Replaying = true;
+		SSD1306PutFontString(s, fontSheetCharacterLength, fontSheet);
+		ssd1306Replaying = false;
+		return;
+	}
+#endif
+	uint8_t x = cursorPosX;
+	uint8_t y = cursorPosY*8;
+	
+	SSD1306BlitString(s, fontSheet, fontSheetCharacterLength, &x, &y, false);
+	
+	cursorPosX = x;
+	cursorPosY = y >> 3;
+ }
+ 
+ 
+ 
+ /**
+ * \brief Puts a font string at the location passed
+ *
+ */
+ void SSD1306PutFontStringAtLocation(
+	char* s,
+	uint8_t fontSheetCharacterLength,
+	char fontSheet[],
+	uint8_t x, uint8_t y
+ )
+ {
+#if SSD1306_STRIP_MODE == 1
+	if(!ssd1306Replaying)
+	{
+		uint8_t args[3 + SSD1306_OP_POINTER] = {x, y, fontSheetCharacterLength};
+		memcpy(&args[3], &fontSheet, SSD1306_OP_POINTER);
+		SSD1306ListAdd(SSD1306_OP_FONT_STRING_AT, args, s);
+		
+		ssd1306Replaying = true;
+		SSD1306PutFontStringAtLocation(s, fontSheetCharacterLength, fontSheet, x, y);
+		ssd1306Replaying = false;
+		return;
+	}
+#endif
+	 
+	if(x*fontSheetCharacterLength > SSD1306_WIDTH || y > (SSD1306_PAGES-1))
+	{
+		return;// out of display
+	}
+	
+	x *= fontSheetCharacterLength;
+	y *= 8;
+	
+	SSD1306BlitString(s, fontSheet, fontSheetCharacterLength, &x, &y, false);
+	
+	cursorPosX = x;
+	cursorPosY = y >> 3;
+ }
+ 
+ 
+ 
+ /**
+  * \brief Writes a char onto the screen
+  * 
+  * 
+  * \param c -The char
+  */
+ void SSD1306WriteFontLine(const char fontSheet[], uint8_t fontSheetCharacterLength) 
+ {
+#if SSD1306_STRIP_MODE == 1
+	if(!ssd1306Replaying)
+	{
+		uint8_t args[3 + SSD1306_OP_POINTER] = {cursorPosX, cursorPosY, fontSheetCharacterLength};
+		memcpy(&args[3], &fontSheet, SSD1306_OP_POINTER);
+		SSD1306ListAdd(SSD1306_OP_FONT_LINE, args, 0);
+		
+		cursorPosX += fontSheetCharacterLength;
+		return;
+	}
+#endif
+
+ 	for (uint8_t j = 0; j < fontSheetCharacterLength; j++)
+	{
+		SSD1306PutChar(fontSheet[j]);
+		cursorPosX+=1;		
+	}
+ }
+ 
+ 
+ 
+ /**
+ * \brief Writes the font array passed onto the screen
+ *
+ */
+ void SSD1306WriteFontToLocation(
+ uint8_t fontSheetCharacterLength,
+ uint8_t fontSheetCharacterWidth,
+ char fontSheet[],
+ uint8_t x, uint8_t y
+ )
+ {
+#if SSD1306_STRIP_MODE == 1
+	if(!ssd1306Replaying)
+	{
+		uint8_t args[4 + SSD1306_OP_POINTER] = {fontSheetCharacterLength, fontSheetCharacterWidth, x, y};
+		memcpy(&args[4], &fontSheet, SSD1306_OP_POINTER);
+		SSD1306ListAdd(SSD1306_OP_FONT_AT, args, 0);
+		
+		ssd1306Replaying = true;
+		SSD1306WriteFontToLocation(fontSheetCharacterLength, fontSheetCharacterWidth, fontSheet, x, y);
+		ssd1306Replaying = false;
+		return;
+	}
+#endif
+
+	unsigned char currentFontChar[fontSheetCharacterWidth];
+ 	
+ 	memset(currentFontChar,0x00,fontSheetCharacterWidth);
+	
+	SSD1306GoToPosition(x,y,fontSheetCharacterWidth);
+	 
+	for (uint8_t i = 0; i < fontSheetCharacterLength; i++)
+	{
+		for(uint8_t j = 0; j < fontSheetCharacterWidth; j++)
+		{
+			currentFontChar[j] = fontSheet[j+i*fontSheetCharacterWidth];
+		}
+		SSD1306WriteFontLine(currentFontChar,fontSheetCharacterWidth);	 
+		SSD1306GoToPosition(x,y+1,fontSheetCharacterWidth);
+	}
+	 
+	 
+	 
+ }
+
+
+
+/**
+ * \brief Draws a single pixel on the screen
+ * 
+ * 
+ * \param x 	-The x position
+ * \param y 	-The y position
+ * \param color -The color of pixel to draw
+ * \return uint8_t 1 if out of display, 0 if worked
+ */
+uint8_t SSD1306DrawPixel(uint8_t x, uint8_t y, uint8_t color) {
+	
+	SSD1306_RECORD_DRAW(SSD1306_OP_PIXEL, x, y, color);
+	
+	uint16_t index = (y / 8);
+    
+	if( x > SSD1306_WIDTH-1 || y > (SSD1306_PAGES*8-1)) {
+		return 1; // out of Display
+	}
+	
+    
+#if defined(SSD1306_DRAW_IMMEDIATE) && SSD1306_DRAW_IMMEDIATE > 0
+    SSD1306GoToPixelPosition(x,index);
+    
+    if( color == SSD1306_WHITE)
+	{
+        SSD1306SendData((1 << (y % 8)));
+	}
+	else
+	{
+        SSD1306SendData(~(1 << (y % 8)));
+	}
+    
+#else
+    uint8_t* row = SSD1306BufferRow(index);
+    
+    if(row == 0)
+    {
+        return 0; // page not being drawn
+    }
+    
+    if( color == SSD1306_WHITE)
+	{
+		SSD1306BufferWrite(index, x, row[x] | (1 << (y % 8)));
+	}
+	else
+	{
+		SSD1306BufferWrite(index, x, row[x] & ~(1 << (y % 8)));
+	}
+    
+#endif
+    
+   
+	return 0;
+	
+}
+
+
+
+#if !defined(SSD1306_DRAW_IMMEDIATE) || SSD1306_DRAW_IMMEDIATE < 1
+
+///Page byte mask from a row in the page down to the bottom of the page
+static const uint8_t ssd1306SpanTopMask[8] = {0xFF, 0xFE, 0xFC, 0xF8, 0xF0, 0xE0, 0xC0, 0x80};
+
+///Page byte mask from the top of the page down to a row in the page
+static const uint8_t ssd1306SpanBottomMask[8] = {0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF};
+
+#endif
+
+
+
+/**
+ * \brief Fills the area between two corners, both included, a page byte at a time. \n
+ * The area is clipped to the display and the changed columns are marked dirty once per page.
+ * 
+ * 
+ * \param x1 	-The first x position
+ * \param y1 	-The first y position
+ * \param x2 	-The second x position
+ * \param y2 	-The second y position
+ * \param color -The color to fill with
+ * \return uint8_t 1 if any of the area was out of display, 0 if all of it was drawn
+ */
+static uint8_t SSD1306FillSpan(int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint8_t color)
+{
+	uint8_t result = 0;
+	
+	if(x1 > x2)
+	{
+		int16_t t = x1; x1 = x2; x2 = t;
+	}
+	
+	if(y1 > y2)
+	{
+		int16_t t = y1; y1 = y2; y2 = t;
+	}
+	
+	if(x2 < 0 || y2 < 0 || x1 > SSD1306_WIDTH-1 || y1 > SSD1306_PAGES*8-1)
+	{
+		return 1; // out of Display
+	}
+	
+	if(x1 < 0) { x1 = 0; result = 1; }
+	if(y1 < 0) { y1 = 0; result = 1; }
+	if(x2 > SSD1306_WIDTH-1) { x2 = SSD1306_WIDTH-1; result = 1; }
+	if(y2 > SSD1306_PAGES*8-1) { y2 = SSD1306_PAGES*8-1; result = 1; }
+	
+#if defined(SSD1306_DRAW_IMMEDIATE) && SSD1306_DRAW_IMMEDIATE > 0
+	
+	//Nothing to mask against without the buffer, draw it a pixel at a time
+	for(int16_t y = y1; y <= y2; y++)
+	{
+		for(int16_t x = x1; x <= x2; x++)
+		{
+			SSD1306DrawPixel(x, y, color);
+		}
+	}
+	
+#else
+	
+	uint8_t lastPage = y2 / 8;
+	
+	for(uint8_t page = y1 / 8; page <= lastPage; page++)
+	{
+		uint8_t mask = 0xFF;
+		
+		if(page == y1 / 8)
+		{
+			mask &= ssd1306SpanTopMask[y1 & 7];
+		}
+		
+		if(page == lastPage)
+		{
+			mask &= ssd1306SpanBottomMask[y2 & 7];
+		}
+		
+		uint8_t* row = SSD1306BufferRow(page);
+		uint8_t changedStart = SSD1306_WIDTH;
+		
+		if(row == 0)
+		{
+			continue;
+		}
+		uint8_t changedEnd = 0;
+		
+		for(uint8_t x = x1; x <= x2; x++)
+		{
+			uint8_t data = (color == SSD1306_WHITE) ? (row[x] | mask) : (row[x] & ~mask);
 			
-			SSD1306GoToPosition(cursorPosX-1, cursorPosY,fontSheetCharacterLength);
-			SSD1306PutFontChar(' ', fontSheet, fontSheetCharacterLength);		
-			SSD1306GoToPosition(cursorPosX-1, cursorPosY,fontSheetCharacterLength);
-		break;
+			if(data != row[x])
+			{
+				row[x] = data;
+				
+				if(x < changedStart) changedStart = x;
+				changedEnd = x + 1;
+			}
+		}
 		
-		//Tab
-		case '\t':
-			if( (cursorPosX+4) < (SSD1306_WIDTH / fontSheetCharacterLength)-4 )
+		if(changedEnd != 0)
+		{
+			SSD1306MarkDirty(page, changedStart, changedEnd);
+		}
+	}
+	
+#endif
+	
+	return result;
+}
+
+
+
+/**
+ * \brief Draws a line onto the screen using Bresenham's algorithm. \n
+ * Each straight run of the line is filled as one span.
+ * 
+ * 
+ * \param x1 	-The starting x position
+ * \param y1 	-The starting y position
+ * \param x2 	-The ending x position
+ * \param y2 	-The ending y position
+ * \param color -The color of line to draw
+ * \return uint8_t The result of drawing onto the oled display
+ */
+uint8_t SSD1306DrawLine(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t color) {
+	uint8_t result = 0;
+	
+	SSD1306_RECORD_DRAW(SSD1306_OP_LINE, x1, y1, x2, y2, color);
+	
+	int16_t x = x1;
+	int16_t y = y1;
+	int16_t dx =  abs((int16_t)x2 - x1), sx = x1 < x2 ? 1 : -1;
+	int16_t dy = -abs((int16_t)y2 - y1), sy = y1 < y2 ? 1 : -1;
+	int16_t err = dx + dy;
+	bool xMajor = (dx >= -dy);
+	int16_t runX = x;
+	int16_t runY = y;
+	
+	while(x != x2 || y != y2)
+	{
+		int16_t e2 = 2 * err;
+		int16_t nextX = x;
+		int16_t nextY = y;
+		
+		if(e2 >= dy)
+		{
+			err += dy;
+			nextX += sx;
+		}
+		
+		if(e2 <= dx)
+		{
+			err += dx;
+			nextY += sy;
+		}
+		
+		//Minor axis stepped, the run is done
+		if(xMajor ? (nextY != y) : (nextX != x))
+		{
+			result |= SSD1306FillSpan(runX, runY, x, y, color);
+			runX = nextX;
+			runY = nextY;
+		}
+		
+		x = nextX;
+		y = nextY;
+	}
+	
+	result |= SSD1306FillSpan(runX, runY, x, y, color);
+	
+	return result;
+}
+
+
+
+/**
+ * \brief Draws a rectangle onto the screen
+ * 
+ * 
+ * \param px1 	-The starting x pixel position
+ * \param py1 	-The starting y pixel position
+ * \param px2 	-The ending x pixel position
+ * \param py2 	-The ending y pixel position
+ * \param color -The color of rectangle outline to draw
+ * \return uint8_t The result of drawing onto the oled display
+ */
+uint8_t SSD1306DrawRect(uint8_t px1, uint8_t py1, uint8_t px2, uint8_t py2, uint8_t color) {
+	uint8_t result=0;
+	
+	SSD1306_RECORD_DRAW(SSD1306_OP_RECT, px1, py1, px2, py2, color);
+	
+	result |= SSD1306FillSpan(px1, py1, px2, py1, color);
+	result |= SSD1306FillSpan(px1, py2, px2, py2, color);
+	result |= SSD1306FillSpan(px1, py1, px1, py2, color);
+	result |= SSD1306FillSpan(px2, py1, px2, py2, color);
+			
+	return result;
+}
+
+
+
+/**
+ * \brief Draws a filled rectangle onto the screen
+ * 
+ * 
+ * \param px1 	-The starting x pixel position
+ * \param py1 	-The starting y pixel position
+ * \param px2 	-The ending x pixel position
+ * \param py2 	-The ending y pixel position
+ * \param color -The fill color of rectangle to draw
+ * \return uint8_t The result of drawing onto the oled display
+ */
+uint8_t SSD1306FillRect(uint8_t px1, uint8_t py1, uint8_t px2, uint8_t py2, uint8_t color) {
+	SSD1306_RECORD_DRAW(SSD1306_OP_FILL_RECT, px1, py1, px2, py2, color);
+	
+	return SSD1306FillSpan(px1, py1, px2, py2, color);
+}
+
+
+
+/**
+ * \brief Draws a circle onto the oled's screen
+ * 
+ * 
+ * \param centerX -The center x position of the circle drawn on the screen
+ * \param centerY -The center y position of the circle drawn on the screen
+ * \param radius   -The radius of the circle
+ * \param color    -The color of the circles outline
+ * \return uint8_t -The result of drawing onto the screen
+ */
+uint8_t SSD1306DrawCircle(uint8_t centerX, uint8_t centerY, uint8_t radius, uint8_t color) {
+	uint8_t result=0;
+	
+	SSD1306_RECORD_DRAW(SSD1306_OP_CIRCLE, centerX, centerY, radius, color);
+			
+	int16_t f = 1 - radius;
+	int16_t ddF_x = 1;
+	int16_t ddF_y = -2 * radius;
+	int16_t x = 0;
+	int16_t y = radius;
+			
+	result = SSD1306DrawPixel(centerX  , centerY+radius, color);
+	result = SSD1306DrawPixel(centerX  , centerY-radius, color);
+	result = SSD1306DrawPixel(centerX+radius, centerY  , color);
+	result = SSD1306DrawPixel(centerX-radius, centerY  , color);
+			
+	while (x<y) {
+		if (f >= 0) {
+			y--;
+			ddF_y += 2;
+			f += ddF_y;
+		}
+		x++;
+		ddF_x += 2;
+		f += ddF_x;
+				
+		result = SSD1306DrawPixel(centerX + x, centerY + y, color);
+		result = SSD1306DrawPixel(centerX - x, centerY + y, color);
+		result = SSD1306DrawPixel(centerX + x, centerY - y, color);
+		result = SSD1306DrawPixel(centerX - x, centerY - y, color);
+		result = SSD1306DrawPixel(centerX + y, centerY + x, color);
+		result = SSD1306DrawPixel(centerX - y, centerY + x, color);
+		result = SSD1306DrawPixel(centerX + y, centerY - x, color);
+		result = SSD1306DrawPixel(centerX - y, centerY - x, color);
+	}
+	return result;
+}
+
+
+
+/**
+ * \brief Draws a filled circle onto the oled's screen. \n
+ * Walks one octant with the midpoint algorithm and fills the mirrored rows as spans.
+ * 
+ * 
+ * \param center_x -The center x position of the circle drawn on the screen
+ * \param center_y -The center y position of the circle drawn on the screen
+ * \param radius   -The radius of the circle
+ * \param color    -The fill color of the circle
+ * \return uint8_t -The result of drawing onto the screen
+ */
+uint8_t SSD1306FillCircle(uint8_t center_x, uint8_t center_y, uint8_t radius, uint8_t color) {
+	uint8_t result=0;
+	
+	SSD1306_RECORD_DRAW(SSD1306_OP_FILL_CIRCLE, center_x, center_y, radius, color);
+	
+	int16_t cx = center_x;
+	int16_t cy = center_y;
+	int16_t f = 1 - radius;
+	int16_t ddF_x = 1;
+	int16_t ddF_y = -2 * radius;
+	int16_t x = 0;
+	int16_t y = radius;
+	
+	result |= SSD1306FillSpan(cx - y, cy, cx + y, cy, color);
+	
+	while (x<y) {
+		if (f >= 0) {
+			//The rows at +-y are done growing, fill them before y moves in
+			result |= SSD1306FillSpan(cx - x, cy + y, cx + x, cy + y, color);
+			result |= SSD1306FillSpan(cx - x, cy - y, cx + x, cy - y, color);
+			y--;
+			ddF_y += 2;
+			f += ddF_y;
+		}
+		x++;
+		ddF_x += 2;
+		f += ddF_x;
+		
+		result |= SSD1306FillSpan(cx - y, cy + x, cx + y, cy + x, color);
+		result |= SSD1306FillSpan(cx - y, cy - x, cx + y, cy - x, color);
+	}
+	
+	//Last rows at +-y
+	result |= SSD1306FillSpan(cx - x, cy + y, cx + x, cy + y, color);
+	result |= SSD1306FillSpan(cx - x, cy - y, cx + x, cy - y, color);
+	
+	return result;
+}
+
+
+
+/**
+ * \brief Draws a bitmap onto the OLED screen
+ * 
+ * 
+ * \param x -The x position to draw at
+ * \param y -The y position to draw at
+ * \param picture -const pointer for the picture to draw
+ * \param width   -The width of the bitmap
+ * \param height  -The height of the bitmap
+ * \param color   -The color of the bitmap
+ * \return uint8_t The result of drawing onto the screen
+ */
+uint8_t SSD1306DrawBitmap(uint8_t x, uint8_t y, const uint8_t *picture, uint8_t width, uint8_t height, uint8_t color) 
+{
+	uint8_t result=0,i=0,j=0, byteWidth = (width+7)/8;
+	
+#if SSD1306_STRIP_MODE == 1
+	if(!ssd1306Replaying)
+	{
+		uint8_t args[5 + SSD1306_OP_POINTER] = {x, y, width, height, color};
+		memcpy(&args[5], &picture, SSD1306_OP_POINTER);
+		SSD1306ListAdd(SSD1306_OP_BITMAP, args, 0);
+		return 0;
+	}
+#endif
+	
+	for (j = 0; j < height; j++) {
+		for(i=0; i < width;i++){
+#if defined(__AVR)
+			if(pgm_read_byte(picture + j * byteWidth + i / 8) & (128 >> (i & 7)))
+#else
+            if(*(picture + j * byteWidth + i / 8) & (128 >> (i & 7)))
+#endif
+			{
+				result = SSD1306DrawPixel(x+i, y+j, color);
+			} 
+			else 
+			{
+				result = SSD1306DrawPixel(x+i, y+j, !color);
+			}
+		}
+	}
+	return result;
+}
+
+
+
+/**
+* \brief Draws the passed pointer to the screen
+*
+*/
+uint8_t SSD1306DrawArea(uint8_t x, uint8_t y, uint8_t *picture, uint8_t width, uint8_t height, uint8_t color) 
+{
+	uint8_t result = 0;
+	
+#if SSD1306_STRIP_MODE == 1
+	if(!ssd1306Replaying)
+	{
+		uint8_t args[5 + SSD1306_OP_POINTER] = {x, y, width, height, color};
+		memcpy(&args[5], &picture, SSD1306_OP_POINTER);
+		SSD1306ListAdd(SSD1306_OP_AREA, args, 0);
+		return 0;
+	}
+#endif
+	uint8_t byteWidth = (uint8_t)((width+7)/8);
+	
+	for (uint8_t j = 0; j < height; j++) {
+		for(uint8_t i=0; i < width;i++)
+		{
+			if(*(picture + j * byteWidth + i / 8) & (128 >> (i & 7)))
 			{
-				SSD1306GoToPosition(cursorPosX+4, cursorPosY,fontSheetCharacterLength);
-			}
-			else
+				result = SSD1306DrawPixel(x+i, y+j, color);
+			} 
+			else 
 			{
-				SSD1306GoToPosition(SSD1306_WIDTH / fontSheetCharacterLength, cursorPosY,fontSheetCharacterLength);
+				result = SSD1306DrawPixel(x+i, y+j, !color);
 			}
+		}
+	}
+	return result;
+}
 
-		break;
-		
-		//Next line
-		case '\n':
-			if(cursorPosY < (SSD1306_HEIGHT/8-1))
-			{
-				SSD1306GoToPosition(cursorPosX, cursorPosY+1,fontSheetCharacterLength);
-			}
 
-		break;
-		
-		//Carriage return
-		case '\r':
-			SSD1306GoToPosition(0, cursorPosY, fontSheetCharacterLength);
 
-		break;
+
+
+
+
+
+
+
+#if !defined(SSD1306_DRAW_IMMEDIATE) || SSD1306_DRAW_IMMEDIATE < 1
+/**
+ * Clears the display buffer
+ */
+void SSD1306ClearBuffer()
+{
+#if SSD1306_STRIP_MODE == 1
+    SSD1306ListReset();
+    return;
+#endif
+    
+    for (uint8_t i = 0; i < SSD1306_PAGES; i++)
+	{
+		for(uint8_t j = 0; j < SSD1306_WIDTH; j++)
+		{
+			SSD1306BufferWrite(i, j, 0x00);
+		}
+		//memset(SSD1306DisplayBuffer[i], 0x00, sizeof(SSD1306DisplayBuffer[i]));
+	}
+}
+
+
+
+///Word the sprite blitter combines whole rows in, the host works 8 bytes at a time and the mcu a byte at a time
+#if defined(SSD1306_SIM) && SSD1306_SIM == 1
+typedef uint64_t ssd1306BlitWord;
+#else
+typedef uint8_t ssd1306BlitWord;
+#endif
+
+///Applies a raster op to destination bits d with source bits s, only where mask m is set
+#define SSD1306_RASTER_OP(rop, d, s, m)	\
+	((rop) == SSD1306_ROP_OR ? ((d) | ((s) & (m))) : \
+	 (rop) == SSD1306_ROP_AND_NOT ? ((d) & ~((s) & (m))) : \
+	 (rop) == SSD1306_ROP_XOR ? ((d) ^ ((s) & (m))) : \
+	 (((d) & ~(m)) | ((s) & (m))))
+
+
+
+/**
+ * \brief Applies a raster op to a run of whole bytes a word at a time
+ * \param dest The buffer bytes
+ * \param src The sprite bytes, in RAM
+ * \param count The number of bytes
+ * \param rop The raster op
+ * \return true if any byte changed
+ */
+static bool SSD1306RasterRun(uint8_t* dest, const uint8_t* src, uint8_t count, uint8_t rop)
+{
+	ssd1306BlitWord changed = 0;
+	
+	for(; count >= sizeof(ssd1306BlitWord); count -= sizeof(ssd1306BlitWord))
+	{
+		ssd1306BlitWord d, s, n;
 		
-		////Clear screen
-		//case '\f':
-			//SSD1306ClearScreen();
-		//break;
+		//Copies keep the words unaligned safe, they compile down to plain loads
+		memcpy(&d, dest, sizeof(d));
+		memcpy(&s, src, sizeof(s));
+		n = SSD1306_RASTER_OP(rop, d, s, (ssd1306BlitWord)~(ssd1306BlitWord)0);
+		memcpy(dest, &n, sizeof(n));
+		
+		changed |= d ^ n;
+		dest += sizeof(ssd1306BlitWord);
+		src += sizeof(ssd1306BlitWord);
+	}
+	
+	for(; count > 0; count--)
+	{
+		uint8_t n = SSD1306_RASTER_OP(rop, *dest, *src, 0xFF);
+		
+		changed |= *dest ^ n;
+		*dest++ = n;
+		src++;
+	}
+	
+	return changed != 0;
+}
 
-		default:
+
+
+/**
+ * \brief Draws a page major sprite with a raster op, clipped at every edge of the display
+ * \param x The x position, may be off the left of the display
+ * \param y The y position, may be above the display
+ * \param sprite The sprite, (height+7)/8 pages of width bytes each with the top row in bit 0 like the display ram
+ * \param width The width of the sprite
+ * \param height The height of the sprite
+ * \param rop The raster op
+ * \param fromProgmem If the sprite is in progmem
+ * \return 1 if any of the sprite was out of display, 0 if worked
+ */
+static uint8_t SSD1306BlitSprite(int16_t x, int16_t y, const uint8_t* sprite, uint8_t width, uint8_t height, uint8_t rop, bool fromProgmem)
+{
+	int16_t startColumn = max(0, -x);
+	int16_t endColumn = min((int16_t)width, (int16_t)SSD1306_WIDTH - x);
+	uint8_t result = (startColumn > 0 || endColumn < width || y < 0 || y + height > SSD1306_PAGES*8);
+	
+	if(startColumn >= endColumn)
+	{
+		return 1;
+	}
+	
+	for(uint8_t spritePage = 0; spritePage < (height+7)/8; spritePage++)
+	{
+		const uint8_t* src = &sprite[spritePage*width];
+		int16_t top = y + spritePage*8;
+		uint8_t rows = min(8, height - spritePage*8);
+		uint8_t rowMask = 0xFF >> (8 - rows);
+		
+		//Floor the page so a sprite above the display still shifts the right way
+		int16_t page = (top >= 0) ? top/8 : -((7 - top)/8);
+		uint8_t shift = top - page*8;
+		
+		for(uint8_t half = 0; half < 2; half++, page++)
+		{
+			uint8_t* row = (page >= 0 && page < SSD1306_PAGES) ? SSD1306BufferRow(page) : 0;
+			uint8_t mask = (half == 0) ? (uint8_t)(rowMask << shift) : (uint8_t)(((uint16_t)rowMask << shift) >> 8);
+			bool changed = false;
 			
-			//If c does not fit or is not good
-			if(cursorPosX >= SSD1306_WIDTH-fontSheetCharacterLength)
+			if(row == 0 || mask == 0)
 			{
-				//break
-				break;
+				continue;
 			}
 			
-			//else...
-			for (uint8_t j = 0; j < fontSheetCharacterLength; j++)
+			if(mask == 0xFF && !fromProgmem)
 			{
-				////Check for error
-				//if(cursorPosX+fontSheetCharacterLength > SSD1306_WIDTH)
-				//{
-					//break;
-				//}
-				
-				SSD1306PutChar(fontSheet[j]);
-				cursorPosX+=1;
-				//#if defined(SSD1306_DRAW_IMMEDIATE) && SSD1306_DRAW_IMMEDIATE > 0
-					//SSD1306GoToPixelPosition(cursorPosX+j, cursorPosY);
-					//SSD1306SendData(fontSheet[((c - ' ') * fontSheetCharacterLength)+j]);
-				//#else
-					////SSD1306DisplayBuffer[cursorPosY][cursorPosX+j] = fontSheet[((c - ' ') * fontSheetCharacterLength)+j];
-					//SSD1306DisplayBuffer[cursorPosY][cursorPosX] = fontSheet[j];
-				//#endif			
-				
+				changed = SSD1306RasterRun(&row[x + startColumn], &src[startColumn], endColumn - startColumn, rop);
+			}
+			else
+			{
+				for(int16_t i = startColumn; i < endColumn; i++)
+				{
+					uint16_t bits = (uint16_t)SSD1306FontByte((const char*)src, i, fromProgmem) << shift;
+					uint8_t s = (half == 0) ? (uint8_t)bits : (uint8_t)(bits >> 8);
+					uint8_t* d = &row[x + i];
+					uint8_t n = SSD1306_RASTER_OP(rop, *d, s, mask);
+					
+					changed |= (n != *d);
+					*d = n;
+				}
 			}
 			
-			//cursorPosX+=fontSheetCharacterLength;
-			
-			//if(cursorPosX >= SSD1306_WIDTH)
-			//{
-				//cursorPosX = 0;
-				//cursorPosY += fontSheetCharacterLength;
-			//}
-			//
-			//if(cursorPosY >= SSD1306_HEIGHT)
-			//{
-				//return;
-			//}
-			
-				
-			
+			if(changed)
+			{
+				SSD1306MarkDirty(page, x + startColumn, x + endColumn);
+			}
 			
-		break;
+			if(shift == 0)
+			{
+				break;
+			}
+		}
 	}
- }
+	
+	return result;
+}
 
 
 
- /**
-  * \brief Writes a string onto the screen
-  * 
-  * 
-  * \param s 
-  */
- void SSD1306PutFontString(
- char* s,
- uint8_t fontSheetCharacterLength,
- char fontSheet[]
- )
- {
- 	unsigned char currentFontChar[fontSheetCharacterLength];
- 	
- 	memset(currentFontChar,0x00,fontSheetCharacterLength);
- 	
- 	unsigned short fontLocation = 0;
- 	
- 	
- 	while(*s)
- 	{
-	 	char c = *s++;
-	 	
-	 	if(c >= ' ')
-	 	{
-		 	c -= ' ';
-	 	}
-	 	
-	 	
-	 	fontLocation = c*fontSheetCharacterLength;
-	 	
-	 	for(uint8_t i = 0; i < fontSheetCharacterLength; i++)
-	 	{
-		 	currentFontChar[i] = fontSheet[fontLocation+i];
-	 	}
-	 	
-	 	SSD1306PutFontChar(c,currentFontChar,fontSheetCharacterLength);
- 	}
- 	
- }
- 
- 
- 
- /**
- * \brief Puts a font string at the location passed
- *
+/**
+ * \brief Draws a sprite with a raster op. SSD1306_ROP_XOR drawn twice in the same place puts the background back.
+ * 
+ * 
+ * \param x 	 -The x position, may be off the left of the display
+ * \param y 	 -The y position, may be above the display
+ * \param sprite -The sprite, (height+7)/8 pages of width bytes each with the top row in bit 0 like the display ram
+ * \param width  -The width of the sprite
+ * \param height -The height of the sprite
+ * \param rop 	 -SSD1306_ROP_COPY, SSD1306_ROP_OR, SSD1306_ROP_AND_NOT or SSD1306_ROP_XOR
+ * \return uint8_t 1 if any of the sprite was out of display, 0 if worked
  */
- void SSD1306PutFontStringAtLocation(
-	char* s,
-	uint8_t fontSheetCharacterLength,
-	char fontSheet[],
-	uint8_t x, uint8_t y
- )
- {
-	 
-	 unsigned char currentFontChar[fontSheetCharacterLength];
-	 
-	 memset(currentFontChar,0x00,fontSheetCharacterLength);
-	 
-	 unsigned short fontLocation = 0;
-	 SSD1306GoToPosition(x,y,fontSheetCharacterLength);
-	 
-	 while(*s)
-	 {
-		 char c = *s++;
-		 
-		 if(c >= ' ')
-		 {
-			 c -= ' ';
-		 }
-		 
-		
-		fontLocation = c*fontSheetCharacterLength;
-			 
-		for(uint8_t i = 0; i < fontSheetCharacterLength; i++)
-		{
-				currentFontChar[i] = fontSheet[fontLocation+i];
-				
-		}
-		 
-		 SSD1306PutFontChar(c,currentFontChar,fontSheetCharacterLength);
-	 }
-	 
-	 
- }
- 
- 
- 
- /**
-  * \brief Writes a char onto the screen
-  * 
-  * 
-  * \param c -The char
-  */
- void SSD1306WriteFontLine(const char fontSheet[], uint8_t fontSheetCharacterLength) 
- {
-
- 	for (uint8_t j = 0; j < fontSheetCharacterLength; j++)
+uint8_t SSD1306DrawSprite(int16_t x, int16_t y, const uint8_t* sprite, uint8_t width, uint8_t height, uint8_t rop)
+{
+#if SSD1306_STRIP_MODE == 1
+	if(!ssd1306Replaying)
 	{
-		SSD1306PutChar(fontSheet[j]);
-		cursorPosX+=1;		
+		uint8_t args[8 + SSD1306_OP_POINTER] = {x & 0xFF, (uint16_t)x >> 8, y & 0xFF, (uint16_t)y >> 8, width, height, rop, false};
+		memcpy(&args[8], &sprite, SSD1306_OP_POINTER);
+		SSD1306ListAdd(SSD1306_OP_SPRITE, args, 0);
+		return 0;
 	}
- }
- 
- 
- 
- /**
- * \brief Writes the font array passed onto the screen
- *
+#endif
+
+	return SSD1306BlitSprite(x, y, sprite, width, height, rop, false);
+}
+
+
+#if defined(__AVR)
+/**
+ * \brief Draws a sprite held in progmem with a raster op
+ * 
+ * 
+ * \param x 	 -The x position, may be off the left of the display
+ * \param y 	 -The y position, may be above the display
+ * \param sprite -The progmem sprite, laid out like SSD1306DrawSprite's
+ * \param width  -The width of the sprite
+ * \param height -The height of the sprite
+ * \param rop 	 -SSD1306_ROP_COPY, SSD1306_ROP_OR, SSD1306_ROP_AND_NOT or SSD1306_ROP_XOR
+ * \return uint8_t 1 if any of the sprite was out of display, 0 if worked
  */
- void SSD1306WriteFontToLocation(
- uint8_t fontSheetCharacterLength,
- uint8_t fontSheetCharacterWidth,
- char fontSheet[],
- uint8_t x, uint8_t y
- )
- {
+uint8_t SSD1306DrawSpriteP(int16_t x, int16_t y, const uint8_t* sprite, uint8_t width, uint8_t height, uint8_t rop)
+{
+#if SSD1306_STRIP_MODE == 1
+	if(!ssd1306Replaying)
+	{
+		uint8_t args[8 + SSD1306_OP_POINTER] = {x & 0xFF, (uint16_t)x >> 8, y & 0xFF, (uint16_t)y >> 8, width, height, rop, true};
+		memcpy(&args[8], &sprite, SSD1306_OP_POINTER);
+		SSD1306ListAdd(SSD1306_OP_SPRITE, args, 0);
+		return 0;
+	}
+#endif
 
-	unsigned char currentFontChar[fontSheetCharacterWidth];
- 	
- 	memset(currentFontChar,0x00,fontSheetCharacterWidth);
+	return SSD1306BlitSprite(x, y, sprite, width, height, rop, true);
+}
+#endif
+
+
+
+#if SSD1306_STRIP_MODE == 1
+
+/**
+ * \brief Draws the display list into the strip for one page
+ * \param page The page to draw
+ */
+static void SSD1306DrawStrip(uint8_t page)
+{
+	uint16_t savedCursorX = cursorPosX;
+	uint16_t savedCursorY = cursorPosY;
+	uint16_t i = 0;
 	
-	SSD1306GoToPosition(x,y,fontSheetCharacterWidth);
-	 
-	for (uint8_t i = 0; i < fontSheetCharacterLength; i++)
+	memset(ssd1306Strip, 0x00, SSD1306_WIDTH);
+	ssd1306StripPage = page;
+	ssd1306Replaying = true;
+	
+	while(i < ssd1306DisplayListLength)
 	{
-		for(uint8_t j = 0; j < fontSheetCharacterWidth; j++)
+		uint8_t op = ssd1306DisplayList[i++];
+		uint8_t* a = &ssd1306DisplayList[i];
+		void* pointer = 0;
+		char* text = 0;
+		
+		i += ssd1306OpLengths[op];
+		
+		switch(op)
+		{
+			case SSD1306_OP_BITMAP:
+			case SSD1306_OP_AREA:
+				memcpy(&pointer, &a[5], SSD1306_OP_POINTER);
+				break;
+			case SSD1306_OP_FONT_CHAR:
+			case SSD1306_OP_FONT_AT:
+			case SSD1306_OP_FONT_DRAW:
+				memcpy(&pointer, &a[4], SSD1306_OP_POINTER);
+				break;
+			case SSD1306_OP_SCALED_STRING:
+				memcpy(&pointer, &a[5], SSD1306_OP_POINTER);
+				break;
+			case SSD1306_OP_FONT_STRING:
+			case SSD1306_OP_FONT_STRING_AT:
+			case SSD1306_OP_FONT_LINE:
+				memcpy(&pointer, &a[3], SSD1306_OP_POINTER);
+				break;
+			case SSD1306_OP_SPRITE:
+				memcpy(&pointer, &a[8], SSD1306_OP_POINTER);
+				break;
+			case SSD1306_OP_PACKED_STRING:
+				memcpy(&pointer, &a[2], SSD1306_OP_POINTER);
+				break;
+			default:
+				break;
+		}
+		
+		//String opcodes carry a length byte and the terminated characters
+		if(op == SSD1306_OP_FONT_STRING || op == SSD1306_OP_FONT_STRING_AT || op == SSD1306_OP_FONT_DRAW || op == SSD1306_OP_PACKED_STRING || op == SSD1306_OP_SCALED_STRING)
 		{
-			currentFontChar[j] = fontSheet[j+i*fontSheetCharacterWidth];
+			uint8_t length = ssd1306DisplayList[i++];
+			text = (char*)&ssd1306DisplayList[i];
+			i += length + 1;
+		}
+		
+		switch(op)
+		{
+			case SSD1306_OP_PIXEL:			SSD1306DrawPixel(a[0], a[1], a[2]); break;
+			case SSD1306_OP_LINE:			SSD1306DrawLine(a[0], a[1], a[2], a[3], a[4]); break;
+			case SSD1306_OP_RECT:			SSD1306DrawRect(a[0], a[1], a[2], a[3], a[4]); break;
+			case SSD1306_OP_FILL_RECT:		SSD1306FillRect(a[0], a[1], a[2], a[3], a[4]); break;
+			case SSD1306_OP_CIRCLE:			SSD1306DrawCircle(a[0], a[1], a[2], a[3]); break;
+			case SSD1306_OP_FILL_CIRCLE:	SSD1306FillCircle(a[0], a[1], a[2], a[3]); break;
+			case SSD1306_OP_BITMAP:			SSD1306DrawBitmap(a[0], a[1], (const uint8_t*)pointer, a[2], a[3], a[4]); break;
+			case SSD1306_OP_AREA:			SSD1306DrawArea(a[0], a[1], (uint8_t*)pointer, a[2], a[3], a[4]); break;
+			case SSD1306_OP_WRITE:			SSD1306WriteToBuffer(a[0], a[1], a[2]); break;
+			
+			case SSD1306_OP_PUT_CHAR:
+				cursorPosX = a[0];
+				cursorPosY = a[1];
+				SSD1306PutChar(a[2]);
+				break;
+				
+			case SSD1306_OP_FONT_CHAR:
+				cursorPosX = a[0];
+				cursorPosY = a[1];
+				SSD1306PutFontChar(a[2], (const char*)pointer, a[3]);
+				break;
+				
+			case SSD1306_OP_FONT_STRING:
+				cursorPosX = a[0];
+				cursorPosY = a[1];
+				SSD1306PutFontString(text, a[2], (char*)pointer);
+				break;
+				
+			case SSD1306_OP_FONT_STRING_AT:	SSD1306PutFontStringAtLocation(text, a[2], (char*)pointer, a[0], a[1]); break;
+			
+			case SSD1306_OP_FONT_LINE:
+				cursorPosX = a[0];
+				cursorPosY = a[1];
+				SSD1306WriteFontLine((const char*)pointer, a[2]);
+				break;
+				
+			case SSD1306_OP_FONT_AT:		SSD1306WriteFontToLocation(a[0], a[1], (char*)pointer, a[2], a[3]); break;
+			
+			case SSD1306_OP_FONT_DRAW:
+#if defined(__AVR)
+				if(a[3])
+				{
+					SSD1306DrawFontStringP(a[0], a[1], text, (PGM_P)pointer, a[2]);
+					break;
+				}
+#endif
+				SSD1306DrawFontString(a[0], a[1], text, (const char*)pointer, a[2]);
+				break;
+			
+			case SSD1306_OP_SPRITE:
+				SSD1306BlitSprite((int16_t)(a[0] | (a[1] << 8)), (int16_t)(a[2] | (a[3] << 8)), (const uint8_t*)pointer, a[4], a[5], a[6], a[7]);
+				break;
+			
+			case SSD1306_OP_PACKED_STRING:	SSD1306DrawPackedString(a[0], a[1], text, (const uint8_t*)pointer); break;
+			
+			case SSD1306_OP_SCALED_STRING:
+				SSD1306BlitScaledString(text, (const char*)pointer, a[2], a[3], a[0], a[1], a[4]);
+				break;
+			
+			default:
+				//Unknown opcode, the list is corrupt
+				i = ssd1306DisplayListLength;
+				break;
 		}
-		SSD1306WriteFontLine(currentFontChar,fontSheetCharacterWidth);	 
-		SSD1306GoToPosition(x,y+1,fontSheetCharacterWidth);
 	}
-	 
-	 
-	 
- }
+	
+	//The strip keeps the page, but later recorded calls must not draw into it
+	ssd1306StripPage = SSD1306_STRIP_NO_PAGE;
+	ssd1306Replaying = false;
+	cursorPosX = savedCursorX;
+	cursorPosY = savedCursorY;
+}
 
 
 
 /**
- * \brief Draws a single pixel on the screen
- * 
- * 
- * \param x 	-The x position
- * \param y 	-The y position
- * \param color -The color of pixel to draw
- * \return uint8_t 1 if out of display, 0 if worked
+ * \brief Draws and sends every strip when the display list changed since the last update
  */
-uint8_t SSD1306DrawPixel(uint8_t x, uint8_t y, uint8_t color) {
-	
-	uint16_t index = (y / 8);
-    
-	if( x > SSD1306_WIDTH-1 || y > (SSD1306_HEIGHT-1)) {
-		return 1; // out of Display
-	}
-	
-    
-#if defined(SSD1306_DRAW_IMMEDIATE) && SSD1306_DRAW_IMMEDIATE > 0
-    SSD1306GoToPixelPosition(x,index);
-    
-    if( color == SSD1306_WHITE)
+static void SSD1306SendDirtySpans()
+{
+	if(!ssd1306DisplayListChanged)
 	{
-        SSD1306SendData((1 << (y % 8)));
+		return;
 	}
-	else
+	
+	//Horizontal addressing carries each strip on to the next page
+	SSD1306SetAddressWindow(0, SSD1306_WIDTH-1, 0, SSD1306_PAGES-1);
+	
+	for(uint8_t page = 0; page < SSD1306_PAGES; page++)
 	{
-        SSD1306SendData(~(1 << (y % 8)));
+		SSD1306DrawStrip(page);
+		SSD1306SendDataArray(ssd1306Strip, SSD1306_WIDTH);
 	}
-    
+	
+	ssd1306DisplayListChanged = false;
+}
+
 #else
-    if( color == SSD1306_WHITE)
-	{
-		SSD1306DisplayBuffer[index][x] |= (1 << (y % 8));
-	}
-	else
+
+/**
+ * \brief Sends the dirty span of each page of the front buffer, pages with matching spans share one address window.
+ */
+static void SSD1306SendDirtySpans()
+{
+	uint8_t page = 0;
+	
+	while(page < SSD1306_PAGES)
 	{
-		SSD1306DisplayBuffer[index][x] &= ~(1 << (y % 8));
+		uint8_t startX = ssd1306DirtyStart[page];
+		uint8_t endX = ssd1306DirtyEnd[page];
+		uint8_t endPage = page;
+		
+		//Skip clean pages
+		if(startX >= endX)
+		{
+			page++;
+			continue;
+		}
+		
+		//Grow the window over the following pages with the same span
+		while(endPage+1 < SSD1306_PAGES && ssd1306DirtyStart[endPage+1] == startX && ssd1306DirtyEnd[endPage+1] == endX)
+		{
+			endPage++;
+		}
+		
+		SSD1306SetAddressWindow(startX, endX-1, page, endPage);
+		
+		//Full width rows are contiguous in the buffer, send them in one go
+		if(startX == 0 && endX == SSD1306_WIDTH)
+		{
+			SSD1306SendDataArray(ssd1306SendBuffer[page], (uint16_t)(endPage-page+1)*SSD1306_WIDTH);
+		}
+		else
+		{
+			for(uint8_t i = page; i <= endPage; i++)
+			{
+				SSD1306SendDataArray(&ssd1306SendBuffer[i][startX], endX-startX);
+			}
+		}
+		
+		for(; page <= endPage; page++)
+		{
+			ssd1306DirtyStart[page] = SSD1306_WIDTH;
+			ssd1306DirtyEnd[page] = 0;
+		}
 	}
-    
+}
+
+#endif
+
+
+
+/**
+ * Updates the ssd1306 display. Only the dirty span of each page is sent, pages with matching spans share one address window. \n
+ * With SSD1306_DOUBLE_BUFFER the back buffer is swapped to the front first.
+ */
+void SSD1306Update() 
+{
+#if SSD1306_DOUBLE_BUFFER == 1
+	SSD1306PresentBackBuffer();
 #endif
-    
-   
-	return 0;
 	
+	SSD1306SendDirtySpans();
+	SSD1306Flush();
+    
+#if defined(SSD1306_AUTO_CLEAR_BUFF_ON_UPDATE)
+    SSD1306ClearBuffer();
+#endif
 }
 
 
 
+#if SSD1306_USE_ASYNC == 1
+
+///Interrupt transfer is not running
+#define SSD1306_ASYNC_IDLE		0
+
+///Waiting on the TWI start condition
+#define SSD1306_ASYNC_START		1
+
+///Waiting on the TWI address byte
+#define SSD1306_ASYNC_ADDRESS	2
+
+///Sending the address window commands
+#define SSD1306_ASYNC_COMMAND	3
+
+///Sending the buffer bytes of the window
+#define SSD1306_ASYNC_DATA		4
+
+#if SSD1306_SPI == 1
+
+///Column and page window commands sent with DC low
+#define SSD1306_ASYNC_HEADER_LENGTH	6
+
+#else
+
+///Column and page window commands, each behind a 0x80 control byte, followed by the 0x40 data control byte
+#define SSD1306_ASYNC_HEADER_LENGTH	13
+
+#endif
+
+///Current state of the interrupt transfer
+static volatile uint8_t ssd1306AsyncState = SSD1306_ASYNC_IDLE;
+
+///Page currently being sent
+static volatile uint8_t ssd1306AsyncPage = 0;
+
+///Last page of the current window
+static volatile uint8_t ssd1306AsyncEndPage = 0;
+
+///Index into the header or the column of the page being sent
+static volatile uint8_t ssd1306AsyncIndex = 0;
+
+///The chip select bits captured when the transfer started
+static uint8_t ssd1306AsyncCsMask = 0;
+
+///The buffer captured when the transfer started
+static uint8_t (*ssd1306AsyncBuffer)[SSD1306_WIDTH];
+
+///Dirty spans handed to the transfer, so drawing can keep marking new changes
+static uint8_t ssd1306AsyncStart[SSD1306_HEIGHT/8];
+
+///One past the last column of each handed off span
+static uint8_t ssd1306AsyncEnd[SSD1306_HEIGHT/8];
+
+///The window commands for the current window
+static uint8_t ssd1306AsyncHeader[SSD1306_ASYNC_HEADER_LENGTH];
+
+///Called from the interrupt when a transfer finishes
+static void (*ssd1306AsyncCallback)(void) = 0;
+
+
+
 /**
- * \brief Draws a line onto the screen
- * 
- * 
- * \param x1 	-The starting x position
- * \param y1 	-The starting y position
- * \param x2 	-The ending x position
- * \param y2 	-The ending y position
- * \param color -The color of line to draw
- * \return uint8_t The result of drawing onto the oled display
+ * \brief Finds the next dirty window at or after the page passed and fills in the header for it
+ * \param page The page to start searching from
+ * \return true if a window was found
  */
-uint8_t SSD1306DrawLine(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t color) {
-	uint8_t result = 0;
+static bool SSD1306AsyncLoadWindow(uint8_t page)
+{
+	while(page < SSD1306_HEIGHT/8 && ssd1306AsyncStart[page] >= ssd1306AsyncEnd[page])
+	{
+		page++;
+	}
+	
+	if(page >= SSD1306_HEIGHT/8)
+	{
+		return false;
+	}
 	
-	uint8_t xA = min(x1,x2);
-	uint8_t xB = max(x1,x2);
-	uint8_t yA = min(y1,y2);
-	uint8_t yB = max(y1,y2);
+	uint8_t startX = ssd1306AsyncStart[page];
+	uint8_t endX = ssd1306AsyncEnd[page];
+	uint8_t endPage = page;
 	
-	while(xA < xB || yA < yB)
+	//Grow the window over the following pages with the same span
+	while(endPage+1 < SSD1306_HEIGHT/8 && ssd1306AsyncStart[endPage+1] == startX && ssd1306AsyncEnd[endPage+1] == endX)
 	{
-		result = SSD1306DrawPixel(xA, yA, color);
-		if(xA < xB) xA++;
-		if(yA < yB) yA++;
-		if(result != 0)
-		{
-			
-			break;
-			
-		}
+		endPage++;
 	}
 	
-	return result;
+	ssd1306AsyncPage = page;
+	ssd1306AsyncEndPage = endPage;
+	ssd1306AsyncIndex = 0;
 	
+#if SSD1306_SPI == 1
+	ssd1306AsyncHeader[0] = SSD1306_SET_COLUMN_ADDR;
+	ssd1306AsyncHeader[1] = startX;
+	ssd1306AsyncHeader[2] = endX-1;
+	ssd1306AsyncHeader[3] = SSD1306_SET_PAGE_RANGE;
+	ssd1306AsyncHeader[4] = page;
+	ssd1306AsyncHeader[5] = endPage;
+#else
+	uint8_t commands[6] = {SSD1306_SET_COLUMN_ADDR, startX, endX-1, SSD1306_SET_PAGE_RANGE, page, endPage};
 	
-	//Original code
+	for(uint8_t i = 0; i < sizeof(commands); i++)
+	{
+		ssd1306AsyncHeader[i*2] = 0x80;
+		ssd1306AsyncHeader[i*2+1] = commands[i];
+	}
 	
-	////for(uint8_t i = xA; i < SSD1306_WIDTH && i < xB; i++)
-	////{
-		////
-	////}
-	//
-	//int dx =  abs(x2-x1), sx = x1<x2 ? 1 : -1;
-	//int dy = -abs(y2-y1), sy = y1<y2 ? 1 : -1;
-	//int err = dx+dy, e2; /* error value e_xy */
-	//
-	//while(1) {
-		//result = SSD1306DrawPixel(x1, y1, color);
-		//if (x1==x2 && y1==y2) break;
-		//e2 = 2*err;
-		//if (e2 > dy) {
-			//err += dy; x1 += sx;
-		//}
-		//
-		//if (e2 < dx) {
-			//err += dx; y1 += sy;
-		//}
-	//}
-			
-	//return result;
+	ssd1306AsyncHeader[SSD1306_ASYNC_HEADER_LENGTH-1] = SSD1306_CMD_SEND_DATA;
+#endif
 	
+	return true;
 }
 
 
 
 /**
- * \brief Draws a rectangle onto the screen
- * 
- * 
- * \param px1 	-The starting x pixel position
- * \param py1 	-The starting y pixel position
- * \param px2 	-The ending x pixel position
- * \param py2 	-The ending y pixel position
- * \param color -The color of rectangle outline to draw
- * \return uint8_t The result of drawing onto the oled display
+ * \brief Ends the interrupt transfer and lets the application know
  */
-uint8_t SSD1306DrawRect(uint8_t px1, uint8_t py1, uint8_t px2, uint8_t py2, uint8_t color) {
-	uint8_t result=0;
+static void SSD1306AsyncFinish()
+{
+#if SSD1306_SPI == 1
+	SPCR &= ~(1 << SPIE);
+#else
+	TWCR = (1 << TWINT)|(1 << TWSTO)|(1 << TWEN);
+#endif
 	
-	result = SSD1306DrawLine(px1, py1, px2, py1, color);
-	result = SSD1306DrawLine(px2, py1, px2, py2, color);
-	result = SSD1306DrawLine(px2, py2, px1, py2, color);
-	result = SSD1306DrawLine(px1, py2, px1, py1, color);
-			
-	return result;
-}
-
-
-
-/**
- * \brief Draws a filled rectangle onto the screen
- * 
- * 
- * \param px1 	-The starting x pixel position
- * \param py1 	-The starting y pixel position
- * \param px2 	-The ending x pixel position
- * \param py2 	-The ending y pixel position
- * \param color -The fill color of rectangle to draw
- * \return uint8_t The result of drawing onto the oled display
- */
-uint8_t SSD1306FillRect(uint8_t px1, uint8_t py1, uint8_t px2, uint8_t py2, uint8_t color) {
-	uint8_t result=0;
-			
-	if( px1 > px2) {
-        
-        px1 ^= px2;
-        px2 ^= px1;
-        px1 ^= px2;
-		
-        py1 ^= py2;
-        py2 ^= py1;
-        py1 ^= py2;
-        
-	}
-	for (uint8_t i=0; i<=(py2-py1); i++) {
-		result = SSD1306DrawLine(px1, py1+i, px2, py1+i, color);
+	ssd1306AsyncState = SSD1306_ASYNC_IDLE;
+	
+	if(ssd1306AsyncCallback != 0)
+	{
+		ssd1306AsyncCallback();
 	}
-			
-	return result;
 }
 
 
 
 /**
- * \brief Draws a circle onto the oled's screen
- * 
- * 
- * \param centerX -The center x position of the circle drawn on the screen
- * \param centerY -The center y position of the circle drawn on the screen
- * \param radius   -The radius of the circle
- * \param color    -The color of the circles outline
- * \return uint8_t -The result of drawing onto the screen
+ * \brief Gets the next buffer byte of the current window
+ * \return true if there was a byte left, false when the window is done
  */
-uint8_t SSD1306DrawCircle(uint8_t centerX, uint8_t centerY, uint8_t radius, uint8_t color) {
-	uint8_t result=0;
-			
-	int16_t f = 1 - radius;
-	int16_t ddF_x = 1;
-	int16_t ddF_y = -2 * radius;
-	int16_t x = 0;
-	int16_t y = radius;
-			
-	result = SSD1306DrawPixel(centerX  , centerY+radius, color);
-	result = SSD1306DrawPixel(centerX  , centerY-radius, color);
-	result = SSD1306DrawPixel(centerX+radius, centerY  , color);
-	result = SSD1306DrawPixel(centerX-radius, centerY  , color);
-			
-	while (x<y) {
-		if (f >= 0) {
-			y--;
-			ddF_y += 2;
-			f += ddF_y;
+static inline bool SSD1306AsyncNextData(uint8_t* data)
+{
+	uint8_t page = ssd1306AsyncPage;
+	
+	if(ssd1306AsyncIndex >= ssd1306AsyncEnd[page])
+	{
+		if(page >= ssd1306AsyncEndPage)
+		{
+			return false;
 		}
-		x++;
-		ddF_x += 2;
-		f += ddF_x;
-				
-		result = SSD1306DrawPixel(centerX + x, centerY + y, color);
-		result = SSD1306DrawPixel(centerX - x, centerY + y, color);
-		result = SSD1306DrawPixel(centerX + x, centerY - y, color);
-		result = SSD1306DrawPixel(centerX - x, centerY - y, color);
-		result = SSD1306DrawPixel(centerX + y, centerY + x, color);
-		result = SSD1306DrawPixel(centerX - y, centerY + x, color);
-		result = SSD1306DrawPixel(centerX + y, centerY - x, color);
-		result = SSD1306DrawPixel(centerX - y, centerY - x, color);
+		
+		page++;
+		ssd1306AsyncPage = page;
+		ssd1306AsyncIndex = ssd1306AsyncStart[page];
 	}
-	return result;
+	
+	*data = ssd1306AsyncBuffer[page][ssd1306AsyncIndex++];
+	return true;
 }
 
 
 
+#if SSD1306_SPI == 1
+
 /**
- * \brief Draws a filled circle onto the oled's screen
- * 
- * 
- * \param center_x -The center x position of the circle drawn on the screen
- * \param center_y -The center y position of the circle drawn on the screen
- * \param radius   -The radius of the circle
- * \param color    -The fill color of the circle
- * \return uint8_t -The result of drawing onto the screen
+ * \brief SPI transfer complete interrupt. Sends the window commands with DC low, then the window bytes with DC high.
  */
-uint8_t SSD1306FillCircle(uint8_t center_x, uint8_t center_y, uint8_t radius, uint8_t color) {
-	uint8_t result=0;
-	for(uint8_t i=0; i<= radius;i++){
-		result = SSD1306DrawCircle(center_x, center_y, i, color);
+ISR(SPI_STC_vect)
+{
+	uint8_t data = 0;
+	
+	switch(ssd1306AsyncState)
+	{
+		case SSD1306_ASYNC_COMMAND:
+			
+			if(ssd1306AsyncIndex < SSD1306_ASYNC_HEADER_LENGTH)
+			{
+				SPDR = ssd1306AsyncHeader[ssd1306AsyncIndex++];
+				break;
+			}
+			
+			//Window is set, switch over to data
+			SSD1306_SET_DC();
+			ssd1306AsyncState = SSD1306_ASYNC_DATA;
+			ssd1306AsyncIndex = ssd1306AsyncStart[ssd1306AsyncPage];
+			
+			//fall through
+			
+		case SSD1306_ASYNC_DATA:
+			
+			if(SSD1306AsyncNextData(&data))
+			{
+				SPDR = data;
+				break;
+			}
+			
+			SSD1306_CS_PORT |= ssd1306AsyncCsMask;
+			
+			if(SSD1306AsyncLoadWindow(ssd1306AsyncEndPage+1))
+			{
+				SSD1306_CS_PORT &= ~ssd1306AsyncCsMask;
+				SSD1306_CLEAR_DC();
+				ssd1306AsyncState = SSD1306_ASYNC_COMMAND;
+				SPDR = ssd1306AsyncHeader[ssd1306AsyncIndex++];
+			}
+			else
+			{
+				SSD1306AsyncFinish();
+			}
+			
+			break;
+			
+		default:
+			break;
 	}
-	return result;
 }
 
-
+#else
 
 /**
- * \brief Draws a bitmap onto the OLED screen
- * 
- * 
- * \param x -The x position to draw at
- * \param y -The y position to draw at
- * \param picture -const pointer for the picture to draw
- * \param width   -The width of the bitmap
- * \param height  -The height of the bitmap
- * \param color   -The color of the bitmap
- * \return uint8_t The result of drawing onto the screen
+ * \brief TWI interrupt. Sends each window as one transaction: address, the window commands, then the window bytes.
  */
-uint8_t SSD1306DrawBitmap(uint8_t x, uint8_t y, const uint8_t *picture, uint8_t width, uint8_t height, uint8_t color) 
+ISR(TWI_vect)
 {
-	uint8_t result=0,i=0,j=0, byteWidth = (width+7)/8;
+	uint8_t status = TWSR & 0xF8;
+	uint8_t data = 0;
 	
-	for (j = 0; j < height; j++) {
-		for(i=0; i < width;i++){
-#if defined(__AVR)
-			if(pgm_read_byte(picture + j * byteWidth + i / 8) & (128 >> (i & 7)))
-#else
-            if(*(picture + j * byteWidth + i / 8) & (128 >> (i & 7)))
-#endif
+	switch(ssd1306AsyncState)
+	{
+		case SSD1306_ASYNC_START:
+			
+			//Start or repeated start
+			if(status != 0x08 && status != 0x10)
 			{
-				result = SSD1306DrawPixel(x+i, y+j, color);
-			} 
-			else 
+				SSD1306AsyncFinish();
+				break;
+			}
+			
+			TWDR = (SSD1306_ADDRESS << 1) | 0;
+			TWCR = (1 << TWINT)|(1 << TWEN)|(1 << TWIE);
+			ssd1306AsyncState = SSD1306_ASYNC_ADDRESS;
+			break;
+			
+		case SSD1306_ASYNC_ADDRESS:
+			
+			//Address acknowledged
+			if(status != 0x18)
 			{
-				result = SSD1306DrawPixel(x+i, y+j, !color);
+				SSD1306AsyncFinish();
+				break;
 			}
-		}
+			
+			ssd1306AsyncState = SSD1306_ASYNC_COMMAND;
+			
+			//fall through
+			
+		case SSD1306_ASYNC_COMMAND:
+			
+			if(status != 0x18 && status != 0x28)
+			{
+				SSD1306AsyncFinish();
+				break;
+			}
+			
+			if(ssd1306AsyncIndex < SSD1306_ASYNC_HEADER_LENGTH)
+			{
+				TWDR = ssd1306AsyncHeader[ssd1306AsyncIndex++];
+				TWCR = (1 << TWINT)|(1 << TWEN)|(1 << TWIE);
+				break;
+			}
+			
+			ssd1306AsyncState = SSD1306_ASYNC_DATA;
+			ssd1306AsyncIndex = ssd1306AsyncStart[ssd1306AsyncPage];
+			
+			//fall through
+			
+		case SSD1306_ASYNC_DATA:
+			
+			if(status != 0x28)
+			{
+				SSD1306AsyncFinish();
+				break;
+			}
+			
+			if(SSD1306AsyncNextData(&data))
+			{
+				TWDR = data;
+				TWCR = (1 << TWINT)|(1 << TWEN)|(1 << TWIE);
+				break;
+			}
+			
+			if(SSD1306AsyncLoadWindow(ssd1306AsyncEndPage+1))
+			{
+				//Stop followed by a start for the next window
+				ssd1306AsyncState = SSD1306_ASYNC_START;
+				TWCR = (1 << TWINT)|(1 << TWSTA)|(1 << TWSTO)|(1 << TWEN)|(1 << TWIE);
+			}
+			else
+			{
+				SSD1306AsyncFinish();
+			}
+			
+			break;
+			
+		default:
+			break;
 	}
-	return result;
 }
 
+#endif
+
 
 
 /**
-* \brief Draws the passed pointer to the screen
-*
-*/
-uint8_t SSD1306DrawArea(uint8_t x, uint8_t y, uint8_t *picture, uint8_t width, uint8_t height, uint8_t color) 
+ * \brief Starts sending the changed spans of the buffer from the SPI or TWI interrupt and returns right away. \n
+ * Drawing may continue while the transfer runs, bytes changed on pages not yet sent go out with this transfer and are sent again on the next update. \n
+ * With SSD1306_DOUBLE_BUFFER the back buffer is swapped to the front first, so drawing never touches the bytes being sent. \n
+ * SSD1306_AUTO_CLEAR_BUFF_ON_UPDATE is not applied here since the buffer is still being read.
+ * \return 1 if a transfer was started, 0 if nothing had changed
+ */
+uint8_t SSD1306UpdateAsync()
 {
-	uint8_t result = 0;
-	uint8_t byteWidth = (uint8_t)((width+7)/8);
+	SSD1306WaitForTransfer();
+	SSD1306Flush();
 	
-	for (uint8_t j = 0; j < height; j++) {
-		for(uint8_t i=0; i < width;i++)
+#if SSD1306_DOUBLE_BUFFER == 1
+	SSD1306PresentBackBuffer();
+#endif
+	
+	//Hand the dirty spans to the transfer
+	for(uint8_t page = 0; page < SSD1306_HEIGHT/8; page++)
+	{
+		if(page < SSD1306_PAGES)
 		{
-			if(*(picture + j * byteWidth + i / 8) & (128 >> (i & 7)))
-			{
-				result = SSD1306DrawPixel(x+i, y+j, color);
-			} 
-			else 
-			{
-				result = SSD1306DrawPixel(x+i, y+j, !color);
-			}
+			ssd1306AsyncStart[page] = ssd1306DirtyStart[page];
+			ssd1306AsyncEnd[page] = ssd1306DirtyEnd[page];
+		}
+		else
+		{
+			ssd1306AsyncStart[page] = SSD1306_WIDTH;
+			ssd1306AsyncEnd[page] = 0;
 		}
 	}
-	return result;
+	
+	SSD1306ClearDirty();
+	
+	if(!SSD1306AsyncLoadWindow(0))
+	{
+		return 0;
+	}
+	
+	ssd1306AsyncCsMask = ssd1306csMask;
+	ssd1306AsyncBuffer = ssd1306SendBuffer;
+	
+#if SSD1306_SPI == 1
+	
+	ssd1306AsyncState = SSD1306_ASYNC_COMMAND;
+	
+	SSD1306_CS_PORT &= ~ssd1306AsyncCsMask;
+	SSD1306_CLEAR_DC();
+	
+	//Clear any complete flag left from the blocking transfers before enabling the interrupt
+	(void)SPSR;
+	(void)SPDR;
+	
+	SPCR |= (1 << SPIE);
+	SPDR = ssd1306AsyncHeader[ssd1306AsyncIndex++];
+	
+#else
+	
+	ssd1306AsyncState = SSD1306_ASYNC_START;
+	TWCR = (1 << TWINT)|(1 << TWSTA)|(1 << TWEN)|(1 << TWIE);
+	
+#endif
+	
+	return 1;
 }
 
 
 
+/**
+ * \brief Checks if an interrupt driven transfer is still running
+ * \return true if the transfer is busy
+ */
+bool SSD1306IsTransferBusy()
+{
+	return (ssd1306AsyncState != SSD1306_ASYNC_IDLE);
+}
 
 
 
+/**
+ * \brief Waits for any interrupt driven transfer to finish. Global interrupts must be on.
+ */
+void SSD1306WaitForTransfer()
+{
+	while(ssd1306AsyncState != SSD1306_ASYNC_IDLE);
+	
+#if SSD1306_I2C == 1
+	//Let the stop condition finish before the bus is used again
+	while(TWCR & (1 << TWSTO));
+#endif
+}
 
 
 
-
-#if !defined(SSD1306_DRAW_IMMEDIATE) || SSD1306_DRAW_IMMEDIATE < 1
 /**
- * Clears the display buffer
+ * \brief Sets the function called when an interrupt driven transfer finishes. This runs inside the interrupt, keep it short.
+ * \param callback The function to call, or 0 for none
  */
-void SSD1306ClearBuffer()
+void SSD1306SetTransferCallback(void (*callback)(void))
 {
-    for (uint8_t i = 0; i < SSD1306_HEIGHT/8; i++)
-	{
-		for(uint8_t j = 0; j < SSD1306_WIDTH; j++)
-		{
-			SSD1306DisplayBuffer[i][j] = 0x00;
-		}
-		//memset(SSD1306DisplayBuffer[i], 0x00, sizeof(SSD1306DisplayBuffer[i]));
-	}
+	ssd1306AsyncCallback = callback;
 }
 
+#endif
+
+
 
+#if defined(SSD1306_DISPLAY_HEIGHTS)
 
 /**
- * Updates the ssd1306 display
+ * \brief Checks if every display's buffer holds the same image
+ * \return true if the displays can be sent one broadcast
  */
-void SSD1306Update() 
+static bool SSD1306DisplaysMatch()
 {
-
-	SSD1306GoToPixelPosition(0,0);
-#if defined(__AVR)
-    SSD1306SendDataArray(&SSD1306DisplayBuffer[0][0], SSD1306_WIDTH*SSD1306_HEIGHT/8);
+	uint8_t pages = ssd1306DisplayHeights[0]/8;
+	uint8_t pageOffset = pages;
+	
+#if SSD1306_DOUBLE_BUFFER == 1
+	uint8_t* first = ssd1306FrameBuffers[ssd1306FrontBuffer[0]][0];
 #else
-    for(uint8_t i = 0; i < 8; i++)
-    {
-        SSD1306SendDataArray(SSD1306DisplayBuffer[i], sizeof(SSD1306DisplayBuffer[i]));
-    }
-    
+	uint8_t* first = ssd1306FrameBuffers[0][0];
 #endif
-    
-#if defined(SSD1306_AUTO_CLEAR_BUFF_ON_UPDATE)
-    SSD1306ClearBuffer();
+	
+	for(uint8_t i = 1; i < sizeof(ssd1306DisplayHeights); i++)
+	{
+		if(ssd1306DisplayHeights[i]/8 != pages)
+		{
+			return false;
+		}
+		
+#if SSD1306_DOUBLE_BUFFER == 1
+		uint8_t* other = ssd1306FrameBuffers[ssd1306FrontBuffer[i]][pageOffset];
+#else
+		uint8_t* other = ssd1306FrameBuffers[0][pageOffset];
 #endif
+		
+		if(memcmp(first, other, (uint16_t)pages*SSD1306_WIDTH) != 0)
+		{
+			return false;
+		}
+		
+		pageOffset += pages;
+	}
+	
+	return true;
 }
 
+#endif
+
 
 
 /**
- * Updates all ssd1306 displays
+ * Updates all ssd1306 displays. \n
+ * With SSD1306_DISPLAY_HEIGHTS, the displays are sent one broadcast with every cs pin low when their buffers hold the same image, else each display is updated on its own. \n
+ * With the one shared buffer, the whole buffer is sent to every display since the displays may not match each other.
  */
 void SSD1306UpdateAll() 
 {
+	uint8_t selectedDisplay = currentDisplay;
+	
+#if defined(SSD1306_DISPLAY_HEIGHTS)
+	
+#if SSD1306_DOUBLE_BUFFER == 1
+	//Bring every display's back buffer forward first so the comparison sees the new frames
+	for(uint8_t i = 0; i < sizeof(ssd1306csPinPositions); i++)
+	{
+		SSD1306SelectDisplay(i);
+		SSD1306PresentBackBuffer();
+	}
+#endif
 	
-    for(uint8_t i = 0; i < sizeof(ssd1306csPinPositions); i++)
+	if(!SSD1306DisplaysMatch())
 	{
-		SSD1306_CS_PORT &= ~(1 << ssd1306csPinPositions[i]);
+		for(uint8_t i = 0; i < sizeof(ssd1306csPinPositions); i++)
+		{
+			SSD1306SelectDisplay(i);
+			SSD1306SendDirtySpans();
+			
+#if defined(SSD1306_AUTO_CLEAR_BUFF_ON_UPDATE)
+			SSD1306ClearBuffer();
+#endif
+		}
+		
+		SSD1306SelectDisplay(selectedDisplay);
+		return;
 	}
 	
+	//Same image everywhere, send the union of every display's changes to all of them at once
+	SSD1306SelectDisplay(0);
+	
+	for(uint8_t i = 1; i < sizeof(ssd1306csPinPositions); i++)
+	{
+		uint8_t pageOffset = i * ssd1306DisplayPages;
+		
+		for(uint8_t page = 0; page < ssd1306DisplayPages; page++)
+		{
+			if(ssd1306DirtyStarts[pageOffset+page] < ssd1306DirtyEnds[pageOffset+page])
+			{
+				SSD1306MarkDirty(page, ssd1306DirtyStarts[pageOffset+page], ssd1306DirtyEnds[pageOffset+page]);
+			}
+			
+			ssd1306DirtyStarts[pageOffset+page] = SSD1306_WIDTH;
+			ssd1306DirtyEnds[pageOffset+page] = 0;
+		}
+	}
 	
-	SSD1306GoToPixelPosition(0,0);
-#if defined(__AVR)
-    SSD1306SendDataArray(&SSD1306DisplayBuffer[0][0], SSD1306_WIDTH*SSD1306_HEIGHT/8);
 #else
-    for(uint8_t i = 0; i < 8; i++)
-    {
-        SSD1306SendDataArray(SSD1306DisplayBuffer[i], sizeof(SSD1306DisplayBuffer[i]));
-    }
-    
+	
+#if SSD1306_DOUBLE_BUFFER == 1
+	SSD1306PresentBackBuffer();
 #endif
-
-
+	
+	//The displays may not match each other, send all of it
+	SSD1306InvalidateBuffer();
+	
+#endif
+	
+	SSD1306Flush();
+	
 	for(uint8_t i = 0; i < sizeof(ssd1306csPinPositions); i++)
 	{
-		SSD1306_CS_PORT |= (1 << ssd1306csPinPositions[i]);
+		ssd1306csMask |= (1 << ssd1306csPinPositions[i]);
 	}
-
-    
+	
+	SSD1306SendDirtySpans();
+	SSD1306Flush();
+	
 #if defined(SSD1306_AUTO_CLEAR_BUFF_ON_UPDATE)
-    SSD1306ClearBuffer();
+#if defined(SSD1306_DISPLAY_HEIGHTS)
+	for(uint8_t i = 0; i < sizeof(ssd1306csPinPositions); i++)
+	{
+		SSD1306SelectDisplay(i);
+		SSD1306ClearBuffer();
+	}
+#else
+	SSD1306ClearBuffer();
+#endif
 #endif
+	
+	SSD1306SelectDisplay(selectedDisplay);
+}
 
 
 
+/**
+ * \brief Hands the finished frame to the display. With SSD1306_DOUBLE_BUFFER drawing can carry on in the back buffer while the frame is sent. \n
+ * The transfer is interrupt driven when SSD1306_USE_ASYNC is on, otherwise this blocks like SSD1306Update.
+ * \return 1 if a transfer was started, 0 if nothing had changed
+ */
+uint8_t SSD1306SwapBuffers()
+{
+#if SSD1306_USE_ASYNC == 1
+	return SSD1306UpdateAsync();
+#else
+	SSD1306Update();
+	return 1;
+#endif
 }
 
 
+
 /**
  * \brief Checks the status of the display buffer at position
  * \param x -The x position to check
@@ -1207,8 +4026,14 @@ void SSD1306UpdateAll()
  */
 uint8_t SSD1306CheckBuffer(uint8_t x, uint8_t y)
 {
-    if( x > SSD1306_WIDTH-1 || y > (SSD1306_HEIGHT-1)) return 0; // out of Display
-	return SSD1306DisplayBuffer[(y / (SSD1306_HEIGHT/8))][x] & (1 << (y % (SSD1306_HEIGHT/8)));
+    if( x > SSD1306_WIDTH-1 || y > (SSD1306_PAGES*8-1)) return 0; // out of Display
+    
+#if SSD1306_STRIP_MODE == 1
+    SSD1306DrawStrip(y / 8);
+	return ssd1306Strip[x] & (1 << (y % 8));
+#else
+	return SSD1306BufferRow(y / 8)[x] & (1 << (y % 8));
+#endif
 }
 #endif
 
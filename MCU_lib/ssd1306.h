@@ -6,7 +6,24 @@
  * Requires "config.h" file with defined macros: SSD1306_I2C 1 if using i2c or SSD1306_SPI 1 if using spi \n
  * If using SPI, it is required to define SSD1306_CON_PIN_PORT, SSD1306_DC_PIN_POSITION, SSD1306_CS_PORT, SSD1306_CS_PIN_POSITIONS, and SSD1306_RES_PIN_POSITION. \n
  * OPTIONS: SSD1306_DRAW_IMMEDIATE for skipping buffer use and SSD1306_AUTO_CLEAR_BUFF_ON_UPDATE for auto clearing the buffer when updating the display \n
+ * When buffered, SSD1306Update only sends the columns changed since the last update. Call SSD1306InvalidateBuffer to force the whole buffer out. \n
+ * Defining SSD1306_USE_ASYNC as 1 on AVR adds SSD1306UpdateAsync, which sends the changed spans from the SPI or TWI interrupt instead of blocking. \n
+ * Defining SSD1306_DOUBLE_BUFFER as 1 draws into a back buffer, SSD1306SwapBuffers hands it to the transfer. Uses twice the buffer ram. \n
+ * With several SPI displays, defining SSD1306_DISPLAY_HEIGHTS with a height for each cs pin gives every display its own buffer, SSD1306SelectDisplay switches between them. \n
+ * Example for 3 displays: #define SSD1306_DISPLAY_HEIGHTS 64, 32, 32 \n
+ * SSD1306_HEIGHT must be the tallest of them. \n
+ * Defining SSD1306_STRIP_MODE as 1 drops the display buffer for low ram parts. Draw calls are recorded into a display list of SSD1306_DISPLAY_LIST_SIZE bytes, \n
+ * then SSD1306Update draws the list into one page sized strip at a time and sends each strip. \n
+ * In strip mode the draw functions return 0, bitmaps and font sheets are kept by pointer and must stay valid until the list is cleared. \n
+ * Defining SSD1306_USE_QUEUE as 1 holds commands and data in a SSD1306_QUEUE_SIZE byte queue and sends them together in one chip select window or I2C transaction. \n
+ * The queue goes out when it fills, when another display is selected, on updates, and on SSD1306Flush. Call SSD1306Flush after drawing immediately. \n
  * You can also specify SSD1306_WIDTH and SSD1306_HEIGHT for the size of the display. \n
+ * SSD1306ConsoleBegin starts a text console that writes straight to the display and scrolls by moving the display start line, \n
+ * so a new line only clears one page. Leave the buffer alone until SSD1306ConsoleEnd. \n
+ * SSD1306BigNumberSet draws a readout in the 24x19 BIG_NUMBERS digits of "font.h", redrawing only the digits that changed since the last value. \n
+ * SSD1306DrawPackedString draws the packed, variable width fonts of "font.h" straight from flash, fonts taller than 8 rows included. \n
+ * SSD1306DrawScaledString draws a font sheet 2x, 3x or 4x size (SSD1306_DOUBLESIZE for 2x), each glyph column is scaled with a nibble lookup table. \n
+ * Defining SSD1306_SIM as 1 builds for the host against the panel emulator in "ssd1306Sim.h". \n
  * Defining SSD1306_SHOW_ERRORS as 1 will have the errors display on the ide console \n
  * It is also required to have "spi.h" and/or "i2c.h" depending on the mode chosen. \n
  * as well as "mcuDelays.h", "mcuUtils.h, and mcuPinUtils" \n
@@ -30,11 +47,18 @@ extern "C" {
 #endif
 
 #include "config.h"
+
+#if defined(SSD1306_SIM) && SSD1306_SIM == 1
+//Host build, the emulated panels stand in for the bus and pins
+#include "ssd1306Sim.h"
+#endif
+
 #include <stdlib.h>
 #include <stdbool.h>
 #include "mcuDelays.h"
 #include "mcuUtils.h"
 #include "mcuPinUtils.h"
+#include "font.h"
 
 #if defined(__AVR)
 
@@ -55,6 +79,75 @@ extern "C" {
 #ifndef SSD1306_I2C
 #define SSD1306_I2C 0
 #endif
+
+#ifndef SSD1306_USE_ASYNC
+#define SSD1306_USE_ASYNC 0
+#endif
+
+//Interrupt driven transfers need the AVR SPI/TWI interrupts and the display buffer
+#if SSD1306_USE_ASYNC == 1 && (!defined(__AVR) || (defined(SSD1306_DRAW_IMMEDIATE) && SSD1306_DRAW_IMMEDIATE > 0))
+    #warning ssd1306.h: SSD1306_USE_ASYNC needs an AVR target and the display buffer, async transfers are disabled.
+    #undef SSD1306_USE_ASYNC
+    #define SSD1306_USE_ASYNC 0
+#endif
+
+#ifndef SSD1306_DOUBLE_BUFFER
+#define SSD1306_DOUBLE_BUFFER 0
+#endif
+
+#ifndef SSD1306_USE_QUEUE
+#define SSD1306_USE_QUEUE 0
+#endif
+
+#if SSD1306_USE_QUEUE == 1
+
+///Size of the transaction queue in bytes
+#ifndef SSD1306_QUEUE_SIZE
+#define SSD1306_QUEUE_SIZE 32
+#endif
+
+#if SSD1306_QUEUE_SIZE < 8 || SSD1306_QUEUE_SIZE > 255
+    #error ssd1306.h: SSD1306_QUEUE_SIZE must be from 8 to 255
+#endif
+
+#endif
+
+#ifndef SSD1306_STRIP_MODE
+#define SSD1306_STRIP_MODE 0
+#endif
+
+///Most digits a SSD1306BigNumber readout can have
+#ifndef SSD1306_BIG_NUMBER_MAX_DIGITS
+#define SSD1306_BIG_NUMBER_MAX_DIGITS 5
+#endif
+
+///Blank columns between the digits of a SSD1306BigNumber readout
+#ifndef SSD1306_BIG_NUMBER_GAP
+#define SSD1306_BIG_NUMBER_GAP 1
+#endif
+
+#if SSD1306_STRIP_MODE == 1
+
+#if defined(SSD1306_DRAW_IMMEDIATE) && SSD1306_DRAW_IMMEDIATE > 0
+    #error ssd1306.h: SSD1306_STRIP_MODE does not work with SSD1306_DRAW_IMMEDIATE
+#endif
+
+#if SSD1306_DOUBLE_BUFFER == 1 || SSD1306_USE_ASYNC == 1 || defined(SSD1306_DISPLAY_HEIGHTS)
+    #error ssd1306.h: SSD1306_STRIP_MODE has no buffer to double, send from an interrupt or split between displays
+#endif
+
+///Size of the display list in bytes
+#ifndef SSD1306_DISPLAY_LIST_SIZE
+#define SSD1306_DISPLAY_LIST_SIZE 128
+#endif
+
+#endif
+
+#if SSD1306_DOUBLE_BUFFER == 1 && defined(SSD1306_DRAW_IMMEDIATE) && SSD1306_DRAW_IMMEDIATE > 0
+    #warning ssd1306.h: SSD1306_DOUBLE_BUFFER needs the display buffer, double buffering is disabled.
+    #undef SSD1306_DOUBLE_BUFFER
+    #define SSD1306_DOUBLE_BUFFER 0
+#endif
     
 
     
@@ -109,6 +202,36 @@ extern "C" {
 #define SSD1306_WIDTH						128
 #endif
 
+#if defined(SSD1306_DISPLAY_HEIGHTS)
+
+#if defined(SSD1306_DRAW_IMMEDIATE) && SSD1306_DRAW_IMMEDIATE > 0
+    #warning ssd1306.h: SSD1306_DISPLAY_HEIGHTS needs the display buffer, per display buffers are disabled.
+    #undef SSD1306_DISPLAY_HEIGHTS
+#elif SSD1306_SPI != 1
+    #error ssd1306.h: SSD1306_DISPLAY_HEIGHTS is for several SPI displays on SSD1306_CS_PIN_POSITIONS
+#elif __NARG__(SSD1306_DISPLAY_HEIGHTS) != __NARG__(SSD1306_CS_PIN_POSITIONS)
+    #error ssd1306.h: SSD1306_DISPLAY_HEIGHTS needs one height for each of the SSD1306_CS_PIN_POSITIONS
+#endif
+
+#endif
+
+#if defined(SSD1306_DISPLAY_HEIGHTS)
+
+///Helpers for adding up the display heights
+#define _SSD1306_SUM_HEIGHTSV1(h0)								(h0)
+#define _SSD1306_SUM_HEIGHTSV2(h0, h1)							(h0 + h1)
+#define _SSD1306_SUM_HEIGHTSV3(h0, h1, h2)						(h0 + h1 + h2)
+#define _SSD1306_SUM_HEIGHTSV4(h0, h1, h2, h3)					(h0 + h1 + h2 + h3)
+#define _SSD1306_SUM_HEIGHTSV5(h0, h1, h2, h3, h4)				(h0 + h1 + h2 + h3 + h4)
+#define _SSD1306_SUM_HEIGHTSV6(h0, h1, h2, h3, h4, h5)			(h0 + h1 + h2 + h3 + h4 + h5)
+#define _SSD1306_SUM_HEIGHTSV7(h0, h1, h2, h3, h4, h5, h6)		(h0 + h1 + h2 + h3 + h4 + h5 + h6)
+#define _SSD1306_SUM_HEIGHTSV8(h0, h1, h2, h3, h4, h5, h6, h7)	(h0 + h1 + h2 + h3 + h4 + h5 + h6 + h7)
+
+///The height of every display added up, the size of the shared buffer
+#define SSD1306_TOTAL_HEIGHT	VFUNC(_SSD1306_SUM_HEIGHTSV, SSD1306_DISPLAY_HEIGHTS)
+
+#endif
+
 #if SSD1306_HEIGHT == 32
     
 #define SSD1306_ADDRESS 0x3C
@@ -130,9 +253,15 @@ extern "C" {
 #define SSD1306_CMD_SET_VERT_SCROLL_AREA    0xA3
 #define SSD1306_CMD_SEND_CMD				0x00
 #define SSD1306_CMD_SEND_DATA				0x40
+#define SSD1306_CMD_SEND_ONE_CMD			0x80
+#define SSD1306_CMD_SEND_ONE_DATA			0xC0
 #define SSD1306_CMD_SET_CONTRAST			0x81
 #define SSD1306_WHITE						0x01
 #define SSD1306_BLACK						0x00
+#define SSD1306_ROP_COPY					0x00
+#define SSD1306_ROP_OR						0x01
+#define SSD1306_ROP_AND_NOT					0x02
+#define SSD1306_ROP_XOR						0x03
 #define SSD1306_CMD_NORMAL_DISPLAY          0xA6
 #define SSD1306_CMD_INVERT_DISPLAY          0xA7
 #define SSD1306_CMD_DISPLAY_OFF             0xAE
@@ -162,6 +291,7 @@ extern "C" {
 #define SSD1306_SET_HIGHER_COLUMN       0x10
 #define SSD1306_MEMORY_ADDR_MODE        0x20
 #define SSD1306_SET_COLUMN_ADDR         0x21
+#define SSD1306_SET_PAGE_RANGE          0x22
 #define SSD1306_SET_PAGE_ADDR           0xB0
 #define SSD1306_SET_START_LINE          0x40
 #define SSD1306_SET_SEGMENT_REMAP       0xA0
@@ -186,6 +316,7 @@ extern void SSD1306SendData(uint8_t data);
 extern void SSD1306SendMoreData(uint8_t* data);
 extern void SSD1306SendCommandArray(uint8_t cmds[], uint16_t cmdlen);
 extern void SSD1306SendDataArray(uint8_t data[], uint16_t datalen);
+extern void SSD1306Flush();
 extern void SSD1306ClearScreen();
 extern void SSD1306StopScroll();
 extern void SSD1306SetInvert(bool invert);
@@ -193,6 +324,11 @@ extern void SSD1306SetSleep(bool gotoSleep);
 extern void SSD1306SetContrast(uint8_t contrast);
 extern void SSD1306StartScrollRight(uint8_t start, uint8_t stop);
 extern void SSD1306StartScrollLeft(uint8_t start, uint8_t stop);
+extern void SSD1306SetStartLine(uint8_t line);
+extern void SSD1306ConsoleBegin(const char fontSheet[], uint8_t fontSheetCharacterLength);
+extern void SSD1306ConsolePutChar(char c);
+extern void SSD1306ConsolePutString(const char* s);
+extern void SSD1306ConsoleEnd();
 extern void SSD1306GoToPosition(uint8_t x, uint8_t y, uint8_t fontSize);
 extern void SSD1306GoToPixelPosition(uint8_t x, uint8_t y);
 extern void SSD1306PutChar(char c);
@@ -228,6 +364,33 @@ uint8_t fontSheetCharacterWidth,
 char fontSheet[],
 uint8_t x, uint8_t y
 );
+extern uint8_t SSD1306DrawFontString(uint8_t x, uint8_t y, const char* s, const char fontSheet[], uint8_t fontSheetCharacterLength);
+
+#if defined(__AVR)
+extern uint8_t SSD1306DrawFontStringP(uint8_t x, uint8_t y, const char* s, PGM_P fontSheet, uint8_t fontSheetCharacterLength);
+#endif
+extern uint8_t SSD1306DrawPackedString(uint8_t x, uint8_t y, const char* s, const uint8_t* font);
+extern uint8_t SSD1306DrawScaledString(uint8_t x, uint8_t y, const char* s, const char fontSheet[], uint8_t fontSheetCharacterLength, uint8_t scale);
+
+#if defined(__AVR)
+extern uint8_t SSD1306DrawScaledStringP(uint8_t x, uint8_t y, const char* s, PGM_P fontSheet, uint8_t fontSheetCharacterLength, uint8_t scale);
+#endif
+
+#if SSD1306_STRIP_MODE != 1
+///A readout of big digits that remembers the glyph it last drew in each digit
+typedef struct
+{
+	const uint8_t* glyphs;
+	uint8_t x;
+	uint8_t y;
+	uint8_t digits;
+	uint8_t shown[SSD1306_BIG_NUMBER_MAX_DIGITS];
+} SSD1306BigNumber;
+
+extern void SSD1306BigNumberInit(SSD1306BigNumber* field, uint8_t x, uint8_t y, uint8_t digits, const uint8_t* glyphs);
+extern void SSD1306BigNumberInvalidate(SSD1306BigNumber* field);
+extern uint8_t SSD1306BigNumberSet(SSD1306BigNumber* field, int32_t value);
+#endif
 
 
 extern uint8_t SSD1306DrawPixel(uint8_t x, uint8_t y, uint8_t color);
@@ -244,10 +407,29 @@ extern uint8_t SSD1306DrawArea(uint8_t x, uint8_t y, uint8_t *picture, uint8_t w
 #if !defined(SSD1306_DRAW_IMMEDIATE) || SSD1306_DRAW_IMMEDIATE < 1
 extern void SSD1306WriteToBuffer(uint8_t data, unsigned char x, unsigned char y);
 extern void SSD1306ClearBuffer();
+extern uint8_t SSD1306DrawSprite(int16_t x, int16_t y, const uint8_t* sprite, uint8_t width, uint8_t height, uint8_t rop);
+
+#if defined(__AVR)
+extern uint8_t SSD1306DrawSpriteP(int16_t x, int16_t y, const uint8_t* sprite, uint8_t width, uint8_t height, uint8_t rop);
+#endif
+
+extern void SSD1306InvalidateBuffer();
+extern uint8_t SSD1306SwapBuffers();
+
+#if SSD1306_STRIP_MODE == 1
+extern bool SSD1306DisplayListFull();
+#endif
 extern void SSD1306Update();
 extern void SSD1306UpdateAll() ;
 extern uint8_t SSD1306CheckBuffer(uint8_t x, uint8_t y);
 
+#if SSD1306_USE_ASYNC == 1
+extern uint8_t SSD1306UpdateAsync();
+extern bool SSD1306IsTransferBusy();
+extern void SSD1306WaitForTransfer();
+extern void SSD1306SetTransferCallback(void (*callback)(void));
+#endif
+
 #endif
 
 
@@ -0,0 +1,186 @@
+/**
+ * \file ssd1306Bench.c
+ * \author Tim Robbins - R&D Engineer, Atech Training
+ * \brief Host side benchmarks of the ssd1306 draw calls against the panel emulator. \n
+ * Each case draws into the buffer and sends it with SSD1306Update, on a screen cleared before every run. \n
+ * The time to draw and the time to update are taken with SSD1306SimNanoseconds, update time includes the emulator decoding the bus. \n
+ * Bytes, data bytes and transactions are from SSD1306SimGetStats, all figures are the average of each run. \n
+ * BUILD AND RUN, from this folder: \n
+ * gcc -std=gnu11 -O2 -DSSD1306_SIM=1 -I. ssd1306Bench.c ssd1306.c ssd1306Sim.c font.c -o ssd1306Bench && ./ssd1306Bench
+ * \version v2.0
+ */
+#include "ssd1306.h"
+
+#if defined(SSD1306_SIM) && SSD1306_SIM == 1
+
+#if defined(SSD1306_DRAW_IMMEDIATE) && SSD1306_DRAW_IMMEDIATE > 0
+#error ssd1306Bench.c: The benchmarks draw into the buffer, leave SSD1306_DRAW_IMMEDIATE undefined.
+#endif
+
+#include <stdio.h>
+
+///Runs of each case
+#define SSD1306_BENCH_RUNS			200
+
+///A benchmarked draw call, run is the number of the run so each run can draw somewhere else
+typedef struct
+{
+	const char* name;
+
+	///Drawn before timing starts, 0 for a blank screen
+	void (*setup)(uint16_t run);
+
+	void (*draw)(uint16_t run);
+
+} SSD1306BenchCase;
+
+///16x16 ring, rows of 2 bytes with the left pixel in the top bit like SSD1306DrawBitmap takes
+static const uint8_t ssd1306BenchBitmap[32] =
+{
+	0x07,0xE0, 0x18,0x18, 0x20,0x04, 0x40,0x02, 0x40,0x02, 0x80,0x01, 0x80,0x01, 0x80,0x01,
+	0x80,0x01, 0x80,0x01, 0x80,0x01, 0x40,0x02, 0x40,0x02, 0x20,0x04, 0x18,0x18, 0x07,0xE0
+};
+
+///16x16 diamond, 2 pages of 16 columns with the top row in bit 0 like SSD1306DrawSprite takes
+static const uint8_t ssd1306BenchSprite[32] =
+{
+	0x80,0xC0,0xE0,0xF0,0xF8,0xFC,0xFE,0xFF,0xFF,0xFE,0xFC,0xF8,0xF0,0xE0,0xC0,0x80,
+	0x01,0x03,0x07,0x0F,0x1F,0x3F,0x7F,0xFF,0xFF,0x7F,0x3F,0x1F,0x0F,0x07,0x03,0x01
+};
+
+
+
+static void SSD1306BenchPixel(uint16_t run)			{ SSD1306DrawPixel(run % 128, run % 64, 1); }
+static void SSD1306BenchLine(uint16_t run)			{ SSD1306DrawLine(0, run % 64, 127, 63 - run % 64, 1); }
+static void SSD1306BenchRect(uint16_t run)			{ SSD1306DrawRect(run % 32, run % 16, run % 32 + 60, run % 16 + 40, 1); }
+static void SSD1306BenchFillRect(uint16_t run)		{ SSD1306FillRect(run % 32, run % 16, run % 32 + 60, run % 16 + 40, 1); }
+static void SSD1306BenchCircle(uint16_t run)		{ SSD1306DrawCircle(64, 32, 10 + run % 20, 1); }
+static void SSD1306BenchFillCircle(uint16_t run)	{ SSD1306FillCircle(64, 32, 10 + run % 20, 1); }
+static void SSD1306BenchBitmap(uint16_t run)		{ SSD1306DrawBitmap(run % 112, run % 48, ssd1306BenchBitmap, 16, 16, 1); }
+static void SSD1306BenchSprite(uint16_t run)		{ SSD1306DrawSprite(run % 112, run % 48, ssd1306BenchSprite, 16, 16, SSD1306_ROP_XOR); }
+static void SSD1306BenchFontString(uint16_t run)	{ SSD1306DrawFontString(0, run % 56, "Speed 123 km/h", ssd1306oled_font_A, ssd1306oled_font_A_char_length); }
+static void SSD1306BenchPackedString(uint16_t run)	{ SSD1306DrawPackedString(0, run % 56, "Speed 123 km/h", ssd1306oled_font_A_proportional); }
+static void SSD1306BenchScaledString(uint16_t run)	{ SSD1306DrawScaledString(0, run % 48, "123.4", ssd1306oled_font_A, ssd1306oled_font_A_char_length, 2); }
+
+
+
+/**
+* \brief Draws the changing parts of the sample dashboard, a speed readout, a fuel bar and the latest point of a graph
+* \param run The run, used as the reading
+*/
+static void SSD1306BenchDashboardValues(uint16_t run)
+{
+	char speed[6];
+	uint8_t fuel = 100 - run % 100;
+
+	snprintf(speed, sizeof(speed), "%3u", run % 250);
+	SSD1306DrawScaledString(4, 14, speed, ssd1306oled_font_A, ssd1306oled_font_A_char_length, 3);
+
+	SSD1306FillRect(91, 15, 91 + fuel / 4, 20, 1);
+	SSD1306FillRect(91 + fuel / 4 + 1, 15, 116, 20, 0);
+
+	SSD1306DrawPixel(64 + run % 60, 60 - (run * 7) % 20, 1);
+}
+
+
+
+/**
+* \brief Draws the whole sample dashboard, a title bar, labels, frames and the changing values
+* \param run The run, used as the reading
+*/
+static void SSD1306BenchDashboard(uint16_t run)
+{
+	SSD1306FillRect(0, 0, 127, 9, 1);
+	SSD1306DrawPackedString(2, 1, "Trip computer", ssd1306oled_font_A_proportional);
+	SSD1306DrawFontString(4, 38, "km/h", ssd1306oled_font_A, ssd1306oled_font_A_char_length);
+	SSD1306DrawFontString(90, 24, "FUEL", ssd1306oled_font_A, ssd1306oled_font_A_char_length);
+	SSD1306DrawRect(90, 14, 117, 21, 1);
+	SSD1306DrawRect(62, 38, 125, 62, 1);
+	SSD1306DrawCircle(30, 54, 8, 1);
+	SSD1306DrawLine(30, 54, 30 + run % 8, 47, 1);
+	SSD1306BenchDashboardValues(run);
+}
+
+
+
+static const SSD1306BenchCase ssd1306BenchCases[] =
+{
+	{"pixel", 0, SSD1306BenchPixel},
+	{"line", 0, SSD1306BenchLine},
+	{"rect", 0, SSD1306BenchRect},
+	{"fill rect", 0, SSD1306BenchFillRect},
+	{"circle", 0, SSD1306BenchCircle},
+	{"fill circle", 0, SSD1306BenchFillCircle},
+	{"bitmap 16x16", 0, SSD1306BenchBitmap},
+	{"sprite 16x16 xor", 0, SSD1306BenchSprite},
+	{"font string", 0, SSD1306BenchFontString},
+	{"packed string", 0, SSD1306BenchPackedString},
+	{"scaled string 2x", 0, SSD1306BenchScaledString},
+	{"dashboard frame", 0, SSD1306BenchDashboard},
+	{"dashboard tick", SSD1306BenchDashboard, SSD1306BenchDashboardValues}
+};
+
+
+
+/**
+* \brief Runs a case SSD1306_BENCH_RUNS times and prints its averages
+* \param benchCase The case
+*/
+static void SSD1306BenchRun(const SSD1306BenchCase* benchCase)
+{
+	uint64_t drawNs = 0;
+	uint64_t updateNs = 0;
+	SSD1306SimStats total = {0, 0, 0, 0};
+
+	for(uint16_t run = 0; run < SSD1306_BENCH_RUNS; run++)
+	{
+		SSD1306ClearBuffer();
+
+		if(benchCase->setup)
+		{
+			benchCase->setup(run);
+		}
+
+		SSD1306Update();
+		SSD1306Flush();
+		SSD1306SimResetStats();
+
+		uint64_t start = SSD1306SimNanoseconds();
+		benchCase->draw(run + 1);
+		uint64_t drawn = SSD1306SimNanoseconds();
+		SSD1306Update();
+		SSD1306Flush();
+		uint64_t sent = SSD1306SimNanoseconds();
+
+		SSD1306SimStats stats = SSD1306SimGetStats();
+
+		drawNs += drawn - start;
+		updateNs += sent - drawn;
+		total.bytes += stats.bytes;
+		total.dataBytes += stats.dataBytes;
+		total.transactions += stats.transactions;
+	}
+
+	printf("%-18s %10llu %10llu %8lu %8lu %6lu\n", benchCase->name,
+		(unsigned long long)(drawNs / SSD1306_BENCH_RUNS), (unsigned long long)(updateNs / SSD1306_BENCH_RUNS),
+		(unsigned long)(total.bytes / SSD1306_BENCH_RUNS), (unsigned long)(total.dataBytes / SSD1306_BENCH_RUNS),
+		(unsigned long)(total.transactions / SSD1306_BENCH_RUNS));
+}
+
+
+
+int main()
+{
+	SSD1306Initialize(true, 0);
+
+	printf("%-18s %10s %10s %8s %8s %6s\n", "case", "draw ns", "update ns", "bytes", "data", "trans");
+
+	for(uint8_t i = 0; i < sizeof(ssd1306BenchCases) / sizeof(ssd1306BenchCases[0]); i++)
+	{
+		SSD1306BenchRun(&ssd1306BenchCases[i]);
+	}
+
+	return 0;
+}
+
+#endif
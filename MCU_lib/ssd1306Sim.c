@@ -0,0 +1,485 @@
+/**
+ * \file ssd1306Sim.c
+ * \author Tim Robbins - R&D Engineer, Atech Training
+ * \brief Source file for the host side ssd1306 panel emulator
+ * \version v2.0
+ */
+#include "ssd1306Sim.h"
+
+#if defined(SSD1306_SIM) && SSD1306_SIM == 1 && !defined(SSD1306SIM_C)
+#define SSD1306SIM_C	1
+
+#include "ssd1306.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+///State of one emulated controller
+typedef struct
+{
+	uint8_t gddram[SSD1306_SIM_PAGES][SSD1306_SIM_COLUMNS];
+
+	///0 horizontal, 1 vertical, 2 page addressing
+	uint8_t addressingMode;
+
+	uint8_t columnStart;
+	uint8_t columnEnd;
+	uint8_t pageStart;
+	uint8_t pageEnd;
+	uint8_t column;
+	uint8_t page;
+
+	///Column start for page addressing mode, set a nibble at a time
+	uint8_t pageModeColumn;
+
+	uint8_t startLine;
+
+	///A command waiting for its argument bytes
+	uint8_t pending[7];
+	uint8_t pendingLength;
+	uint8_t pendingNeeded;
+
+} SSD1306SimPanel;
+
+volatile uint8_t ssd1306SimConPort = 0xFF;
+volatile uint8_t ssd1306SimCsPorts[1] = {0xFF};
+
+static SSD1306SimPanel ssd1306SimPanels[SSD1306_SIM_PANELS];
+static SSD1306SimStats ssd1306SimStats;
+
+///Set once the panels are in their power on state
+static bool ssd1306SimPoweredUp = false;
+
+///Set when the chip select port was touched since the last byte, so the next byte opens a new window
+static bool ssd1306SimCsTouched = true;
+
+///I2C control byte state, 0 waiting for a control byte, 1 one byte follows, 2 the rest of the transaction follows
+static uint8_t ssd1306SimI2CState = 0;
+static bool ssd1306SimI2CIsData = false;
+
+
+
+/**
+* \brief Resets a panel to the controller's power on state
+* \param panel The panel
+*/
+static void SSD1306SimResetPanel(SSD1306SimPanel* panel)
+{
+	memset(panel, 0x00, sizeof(SSD1306SimPanel));
+	panel->addressingMode = 2;
+	panel->columnEnd = SSD1306_SIM_COLUMNS-1;
+	panel->pageEnd = SSD1306_SIM_PAGES-1;
+}
+
+
+
+/**
+* \brief Resets every panel to the controller's power on state
+*/
+static void SSD1306SimResetPanels()
+{
+	for(uint8_t i = 0; i < SSD1306_SIM_PANELS; i++)
+	{
+		SSD1306SimResetPanel(&ssd1306SimPanels[i]);
+	}
+
+	ssd1306SimPoweredUp = true;
+}
+
+
+
+/**
+* \brief Gets the number of argument bytes that follow a command
+* \param cmd The command
+* \return The number of argument bytes
+*/
+static uint8_t SSD1306SimArgumentCount(uint8_t cmd)
+{
+	switch(cmd)
+	{
+		case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+		case 0xD5: case 0xD8: case 0xD9: case 0xDA: case 0xDB:
+			return 1;
+
+		case 0x21: case 0x22: case 0xA3:
+			return 2;
+
+		case 0x29: case 0x2A:
+			return 5;
+
+		case 0x26: case 0x27:
+			return 6;
+
+		default:
+			return 0;
+	}
+}
+
+
+
+/**
+* \brief Runs a command once all of its arguments are in
+* \param panel The panel
+*/
+static void SSD1306SimRunCommand(SSD1306SimPanel* panel)
+{
+	uint8_t* c = panel->pending;
+
+	if(c[0] == 0x20)
+	{
+		panel->addressingMode = c[1] & 0x03;
+	}
+	else if(c[0] == 0x21)
+	{
+		panel->columnStart = c[1] & 0x7F;
+		panel->columnEnd = c[2] & 0x7F;
+		panel->column = panel->columnStart;
+	}
+	else if(c[0] == 0x22)
+	{
+		panel->pageStart = c[1] & 0x07;
+		panel->pageEnd = c[2] & 0x07;
+		panel->page = panel->pageStart;
+	}
+	else if(c[0] <= 0x0F)
+	{
+		panel->pageModeColumn = (panel->pageModeColumn & 0xF0) | c[0];
+		panel->column = panel->pageModeColumn;
+	}
+	else if(c[0] <= 0x1F)
+	{
+		panel->pageModeColumn = (panel->pageModeColumn & 0x0F) | ((c[0] & 0x07) << 4);
+		panel->column = panel->pageModeColumn;
+	}
+	else if(c[0] >= 0x40 && c[0] <= 0x7F)
+	{
+		panel->startLine = c[0] & 0x3F;
+	}
+	else if(c[0] >= 0xB0 && c[0] <= 0xB7 && panel->addressingMode == 2)
+	{
+		panel->page = c[0] & 0x07;
+	}
+}
+
+
+
+/**
+* \brief Feeds a command byte to a panel
+* \param panel The panel
+* \param cmd The byte
+*/
+static void SSD1306SimCommand(SSD1306SimPanel* panel, uint8_t cmd)
+{
+	if(panel->pendingLength == 0)
+	{
+		panel->pendingNeeded = SSD1306SimArgumentCount(cmd);
+	}
+
+	panel->pending[panel->pendingLength++] = cmd;
+
+	if(panel->pendingLength > panel->pendingNeeded)
+	{
+		SSD1306SimRunCommand(panel);
+		panel->pendingLength = 0;
+	}
+}
+
+
+
+/**
+* \brief Writes a data byte into a panel's GDDRAM and moves its pointers the way the addressing mode does
+* \param panel The panel
+* \param data The byte
+*/
+static void SSD1306SimData(SSD1306SimPanel* panel, uint8_t data)
+{
+	panel->gddram[panel->page][panel->column] = data;
+
+	switch(panel->addressingMode)
+	{
+		case 0:
+			if(panel->column++ >= panel->columnEnd)
+			{
+				panel->column = panel->columnStart;
+				panel->page = (panel->page >= panel->pageEnd) ? panel->pageStart : panel->page+1;
+			}
+			break;
+
+		case 1:
+			if(panel->page++ >= panel->pageEnd)
+			{
+				panel->page = panel->pageStart;
+				panel->column = (panel->column >= panel->columnEnd) ? panel->columnStart : panel->column+1;
+			}
+			break;
+
+		default:
+			//Page addressing wraps within the page
+			panel->column = (panel->column + 1) & (SSD1306_SIM_COLUMNS-1);
+			break;
+	}
+}
+
+
+
+/**
+* \brief Feeds a byte to every panel the byte is going to
+* \param panels Bit for each panel receiving the byte
+* \param isData If the byte is data
+* \param byte The byte
+*/
+static void SSD1306SimReceive(uint8_t panels, bool isData, uint8_t byte)
+{
+	if(!ssd1306SimPoweredUp)
+	{
+		SSD1306SimResetPanels();
+	}
+
+	if(isData)
+	{
+		ssd1306SimStats.dataBytes++;
+	}
+	else
+	{
+		ssd1306SimStats.commandBytes++;
+	}
+
+	for(uint8_t i = 0; i < SSD1306_SIM_PANELS; i++)
+	{
+		if(panels & (1 << i))
+		{
+			if(isData)
+			{
+				SSD1306SimData(&ssd1306SimPanels[i], byte);
+			}
+			else
+			{
+				SSD1306SimCommand(&ssd1306SimPanels[i], byte);
+			}
+		}
+	}
+}
+
+
+
+/**
+* \brief Marks the chip select port as accessed. Used as the index of SSD1306_CS_PORT.
+* \return 0
+*/
+uint8_t SSD1306SimTouchCs()
+{
+	ssd1306SimCsTouched = true;
+	return 0;
+}
+
+
+
+/**
+* \brief Emulated SPI transmit, sends the byte to the panels with chip select low
+* \param data The byte
+*/
+void SpiTransmit(uint8_t data)
+{
+	uint8_t selected = ~ssd1306SimCsPorts[0];
+
+	ssd1306SimStats.bytes++;
+
+	if(ssd1306SimCsTouched && selected != 0)
+	{
+		ssd1306SimStats.transactions++;
+		ssd1306SimCsTouched = false;
+	}
+
+	SSD1306SimReceive(selected, (ssd1306SimConPort & (1 << SSD1306_DC_PIN_POSITION)) != 0, data);
+}
+
+
+
+/**
+* \brief Emulated I2C start condition and address
+* \param i2c_address The address byte
+* \return 0 for no errors
+*/
+uint8_t I2CStart(uint8_t i2c_address)
+{
+	(void)i2c_address;
+
+	ssd1306SimStats.bytes++;
+	ssd1306SimStats.transactions++;
+	ssd1306SimI2CState = 0;
+
+	return 0;
+}
+
+
+
+/**
+* \brief Emulated I2C byte, decodes the control bytes and sends the rest to panel 0
+* \param byte The byte
+* \return 0 for no errors
+*/
+uint8_t I2CByte(uint8_t byte)
+{
+	ssd1306SimStats.bytes++;
+
+	if(ssd1306SimI2CState == 0)
+	{
+		//Co set means one byte follows before the next control byte
+		ssd1306SimI2CIsData = (byte & 0x40) != 0;
+		ssd1306SimI2CState = (byte & 0x80) ? 1 : 2;
+		return 0;
+	}
+
+	SSD1306SimReceive(1, ssd1306SimI2CIsData, byte);
+
+	if(ssd1306SimI2CState == 1)
+	{
+		ssd1306SimI2CState = 0;
+	}
+
+	return 0;
+}
+
+
+
+/**
+* \brief Emulated I2C stop condition
+*/
+void SSD1306SimI2CStop()
+{
+	ssd1306SimI2CState = 0;
+}
+
+
+
+/**
+* \brief Resets every panel to the power on state and clears the counters
+*/
+void SSD1306SimReset()
+{
+	SSD1306SimResetPanels();
+	SSD1306SimResetStats();
+}
+
+
+
+/**
+* \brief Clears the bus counters
+*/
+void SSD1306SimResetStats()
+{
+	memset(&ssd1306SimStats, 0x00, sizeof(ssd1306SimStats));
+}
+
+
+
+/**
+* \brief Gets the bus counters since they were last reset
+* \return The counters
+*/
+SSD1306SimStats SSD1306SimGetStats()
+{
+	return ssd1306SimStats;
+}
+
+
+
+/**
+* \brief Gets a page of a panel's GDDRAM
+* \param panel The panel, the chip select bit or 0 for I2C
+* \param page The page
+* \return The page's SSD1306_SIM_COLUMNS bytes, or 0 if out of range
+*/
+const uint8_t* SSD1306SimGetPage(uint8_t panel, uint8_t page)
+{
+	if(panel >= SSD1306_SIM_PANELS || page >= SSD1306_SIM_PAGES)
+	{
+		return 0;
+	}
+
+	return ssd1306SimPanels[panel].gddram[page];
+}
+
+
+
+/**
+* \brief Gets a pixel as the panel shows it, after the start line
+* \param panel The panel, the chip select bit or 0 for I2C
+* \param x The x position
+* \param y The y position on the screen
+* \return 1 if lit, 0 if not or out of range
+*/
+uint8_t SSD1306SimGetPixel(uint8_t panel, uint8_t x, uint8_t y)
+{
+	if(panel >= SSD1306_SIM_PANELS || x >= SSD1306_SIM_COLUMNS || y >= SSD1306_SIM_PAGES*8)
+	{
+		return 0;
+	}
+
+	uint8_t row = (y + ssd1306SimPanels[panel].startLine) & (SSD1306_SIM_PAGES*8 - 1);
+
+	return (ssd1306SimPanels[panel].gddram[row / 8][x] >> (row % 8)) & 0x01;
+}
+
+
+
+/**
+* \brief Saves what a panel shows as a binary PBM image
+* \param panel The panel, the chip select bit or 0 for I2C
+* \param path The file to write
+* \param width The width of the panel
+* \param height The height of the panel
+* \return true if written
+*/
+bool SSD1306SimWritePbm(uint8_t panel, const char* path, uint8_t width, uint8_t height)
+{
+	FILE* file = fopen(path, "wb");
+
+	if(file == 0)
+	{
+		return false;
+	}
+
+	fprintf(file, "P4\n%u %u\n", width, height);
+
+	for(uint8_t y = 0; y < height; y++)
+	{
+		for(uint8_t x = 0; x < width; x += 8)
+		{
+			uint8_t packed = 0;
+
+			for(uint8_t bit = 0; bit < 8 && x + bit < width; bit++)
+			{
+				packed |= SSD1306SimGetPixel(panel, x + bit, y) << (7 - bit);
+			}
+
+			fputc(packed, file);
+		}
+	}
+
+	return fclose(file) == 0;
+}
+
+
+
+/**
+* \brief Reads the host's monotonic clock for timing draw calls
+* \return Nanoseconds from an arbitrary start
+*/
+uint64_t SSD1306SimNanoseconds()
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+
+
+//The host has nothing to wait for
+void delayForMicroseconds(uint16_t microseconds) { (void)microseconds; }
+void delayForMilliseconds(uint16_t milliseconds) { (void)milliseconds; }
+void delayForTenthSeconds(uint16_t tenthSeconds) { (void)tenthSeconds; }
+
+#endif
@@ -0,0 +1,104 @@
+/**
+ * \file ssd1306Sim.h
+ * \author Tim Robbins - R&D Engineer, Atech Training
+ * \brief Header file for the host side ssd1306 panel emulator. \n
+ * Stands in for the SPI/I2C bus so ssd1306.c can be built, checked and measured on a pc without a display. \n
+ * REQUIREMENTS: \n
+ * Define SSD1306_SIM as 1 in "config.h" or on the compiler command line, then build ssd1306.c and ssd1306Sim.c for the host. \n
+ * The emulator provides SpiTransmit, I2CStart, I2CByte, i2c_stop and the mcuDelays functions, so spi.c, i2c.c and mcuDelays.c are left out. \n
+ * The SPI pins default to the emulated ports below, SSD1306_CS_PIN_POSITIONS may be given as usual for several panels. \n
+ * Each chip select line drives its own panel. I2C always drives panel 0. \n
+ * The command and data stream is decoded into each panel's GDDRAM, honouring the 0x20 addressing mode, the 0x21/0x22 windows, \n
+ * the 0xB0 and column nibble commands of page addressing mode and the 0x40 start line. \n
+ * Bytes and transactions on the bus are counted for measuring the cost of each call, and panels can be saved as PBM images. \n
+ * ssd1306Bench.c is a host program using the counters and SSD1306SimNanoseconds to benchmark each draw call and a sample dashboard. \n
+ * \version v2.0
+ */
+#ifndef __SSD1306SIM_H__
+#define __SSD1306SIM_H__ 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "config.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(SSD1306_SIM) && SSD1306_SIM == 1
+
+///Number of panels, one for each bit of the chip select port
+#define SSD1306_SIM_PANELS			8
+
+///Columns of the controller's GDDRAM
+#define SSD1306_SIM_COLUMNS			128
+
+///Pages of the controller's GDDRAM
+#define SSD1306_SIM_PAGES			8
+
+extern volatile uint8_t ssd1306SimConPort;
+extern volatile uint8_t ssd1306SimCsPorts[1];
+extern uint8_t SSD1306SimTouchCs();
+
+#ifndef SSD1306_CON_PIN_PORT
+#define SSD1306_CON_PIN_PORT		ssd1306SimConPort
+#endif
+
+#ifndef SSD1306_DC_PIN_POSITION
+#define SSD1306_DC_PIN_POSITION		0
+#endif
+
+#ifndef SSD1306_RES_PIN_POSITION
+#define SSD1306_RES_PIN_POSITION	1
+#endif
+
+///Every access to the chip select port goes through SSD1306SimTouchCs so the emulator sees each chip select window
+#ifndef SSD1306_CS_PORT
+#define SSD1306_CS_PORT				ssd1306SimCsPorts[SSD1306SimTouchCs()]
+#endif
+
+#ifndef SSD1306_CS_PIN_POSITIONS
+#define SSD1306_CS_PIN_POSITIONS	0
+#endif
+
+///Bus traffic counted by the emulator
+typedef struct
+{
+	///Every byte on the bus, including I2C addresses and control bytes
+	uint32_t bytes;
+
+	///Command bytes received by the panels
+	uint32_t commandBytes;
+
+	///Data bytes received by the panels
+	uint32_t dataBytes;
+
+	///Chip select windows on SPI, START conditions on I2C
+	uint32_t transactions;
+
+} SSD1306SimStats;
+
+extern void SpiTransmit(uint8_t data);
+extern uint8_t I2CStart(uint8_t i2c_address);
+extern uint8_t I2CByte(uint8_t byte);
+extern void SSD1306SimI2CStop();
+
+#ifndef i2c_stop
+#define i2c_stop()					SSD1306SimI2CStop()
+#endif
+
+extern void SSD1306SimReset();
+extern void SSD1306SimResetStats();
+extern SSD1306SimStats SSD1306SimGetStats();
+extern const uint8_t* SSD1306SimGetPage(uint8_t panel, uint8_t page);
+extern uint8_t SSD1306SimGetPixel(uint8_t panel, uint8_t x, uint8_t y);
+extern bool SSD1306SimWritePbm(uint8_t panel, const char* path, uint8_t width, uint8_t height);
+extern uint64_t SSD1306SimNanoseconds();
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SSD1306SIM_H__ */